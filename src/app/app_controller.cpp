@@ -1,5 +1,7 @@
 #include "app_controller.h"
 
+#include "core_hal.h"
+
 namespace {
 const int PIN_FAN = D0;
 const int PIN_SENSOR_TX = A6;
@@ -17,6 +19,40 @@ const int TFT_RST = -1;
 const uint32_t kReportIntervalMs = 5000;
 const uint32_t kHealthPublishIntervalMs = 30000;
 const uint32_t kDisplayReinitDelayMs = 2500;
+
+struct HealthTopic {
+    MqttTopic topic;
+    MetricId metric;
+};
+
+const HealthTopic kHealthTopics[] = {
+    {MqttTopic::HealthWifiReconnects, MetricId::WifiReconnects},
+    {MqttTopic::HealthMqttReconnects, MetricId::MqttReconnects},
+    {MqttTopic::HealthSensorParseErrors, MetricId::SensorParseErrors},
+    {MqttTopic::HealthCommandDropsButton, MetricId::CommandDropsButton},
+    {MqttTopic::HealthCommandDropsMqtt, MetricId::CommandDropsMqtt},
+    {MqttTopic::HealthCommandDropsWeb, MetricId::CommandDropsWeb},
+    {MqttTopic::HealthMqttPublishDrops, MetricId::MqttPublishDrops},
+};
+
+// Free heap alone hides fragmentation: a heap with plenty free but no large
+// block still fails the next big allocation. The share of free memory outside
+// the largest block is the fragmentation gauge.
+void sampleHeapMetrics(MetricsRegistry& metrics) {
+    runtime_info_t info;
+    memset(&info, 0, sizeof(info));
+    info.size = sizeof(info);
+    HAL_Core_Runtime_Info(&info, nullptr);
+
+    metrics.set(MetricId::HeapFree, info.freeheap);
+    metrics.set(MetricId::HeapMaxUsed, info.max_used_heap);
+    metrics.set(MetricId::HeapLargestFreeBlock, info.largest_free_block_heap);
+    uint32_t fragmentation_pct = 0;
+    if (info.freeheap > 0 && info.largest_free_block_heap <= info.freeheap) {
+        fragmentation_pct = 100 - (info.largest_free_block_heap * 100ULL / info.freeheap);
+    }
+    metrics.set(MetricId::HeapFragmentation, fragmentation_pct);
+}
 }  // namespace
 
 AppController::AppController()
@@ -36,6 +72,9 @@ AppController::AppController()
       last_report_ms_(0),
       last_health_publish_ms_(0),
       last_sensor_sample_ms_(0),
+      last_history_sample_ms_(0),
+      pm25_history_sum_(0),
+      pm25_history_count_(0),
       wifi_ip_visible_until_ms_(0) {}
 
 void AppController::init() {
@@ -60,6 +99,7 @@ void AppController::init() {
     web_.setCommandBatchSink(enqueueBatchFromModule);
 
     mqtt_.setCommandSink(enqueueFromModule, this);
+    mqtt_.setMetrics(&state_.metrics);
 
     if (strlen(settings_.wifi_ssid) == 0) {
         setup_mode_ = true;
@@ -90,7 +130,8 @@ void AppController::tick() {
     tickHealthPublish(now_ms);
 
     if (state_.dirty_publish) {
-        queueStatePublish();
+        queueStatePublish(now_ms);
+        web_.notifyStateChanged();
         state_.dirty_publish = false;
     }
 
@@ -135,6 +176,20 @@ void AppController::tickSensor(uint32_t now_ms) {
         last_sensor_sample_ms_ = state_.last_sensor_packet_ms;
         pm25_avg_.add(state_.pm25_raw);
         pm10_avg_.add(state_.pm10_raw);
+        pm25_history_sum_ += static_cast<uint32_t>(state_.pm25_raw);
+        pm25_history_count_ += 1;
+    }
+
+    if (now_ms - last_history_sample_ms_ >= kPmHistoryIntervalMs) {
+        last_history_sample_ms_ = now_ms;
+        if (pm25_history_count_ > 0) {
+            // One averaged column per interval; a stalled sensor leaves no column.
+            uint32_t avg = pm25_history_sum_ / pm25_history_count_;
+            state_.pm25_history.push(static_cast<uint16_t>(avg > 0xFFFF ? 0xFFFF : avg));
+            pm25_history_sum_ = 0;
+            pm25_history_count_ = 0;
+            state_.dirty_display = true;
+        }
     }
 }
 
@@ -195,15 +250,12 @@ void AppController::tickReport(uint32_t now_ms) {
 void AppController::tickHealthPublish(uint32_t now_ms) {
     if (now_ms - last_health_publish_ms_ >= kHealthPublishIntervalMs) {
         last_health_publish_ms_ = now_ms;
-        state_.mqtt_publish_drop_count = mqtt_.publishDropCount();
-        mqtt_.enqueueStatePublish("health/uptime_s", (now_ms - state_.boot_ms) / 1000);
-        mqtt_.enqueueStatePublish("health/wifi_reconnect_count", state_.wifi_reconnect_count);
-        mqtt_.enqueueStatePublish("health/mqtt_reconnect_count", state_.mqtt_reconnect_count);
-        mqtt_.enqueueStatePublish("health/sensor_parse_errors", state_.sensor_parse_errors);
-        mqtt_.enqueueStatePublish("health/command_drop_button_count", state_.command_drop_button_count);
-        mqtt_.enqueueStatePublish("health/command_drop_mqtt_count", state_.command_drop_mqtt_count);
-        mqtt_.enqueueStatePublish("health/command_drop_web_count", state_.command_drop_web_count);
-        mqtt_.enqueueStatePublish("health/mqtt_publish_drop_count", state_.mqtt_publish_drop_count);
+        sampleHeapMetrics(state_.metrics);
+        state_.metrics.set(MetricId::MqttPublishDrops, mqtt_.publishDropCount());
+        mqtt_.publishValue(MqttTopic::HealthUptime, (now_ms - state_.boot_ms) / 1000, now_ms);
+        for (size_t i = 0; i < sizeof(kHealthTopics) / sizeof(kHealthTopics[0]); ++i) {
+            mqtt_.publishValue(kHealthTopics[i].topic, state_.metrics.get(kHealthTopics[i].metric), now_ms);
+        }
     }
 }
 
@@ -263,15 +315,15 @@ void AppController::recordCommandDrop(CommandSource source, uint32_t count) {
     }
 
     if (source == CommandSource::Button) {
-        state_.command_drop_button_count += count;
+        state_.metrics.add(MetricId::CommandDropsButton, count);
         return;
     }
     if (source == CommandSource::Mqtt) {
-        state_.command_drop_mqtt_count += count;
+        state_.metrics.add(MetricId::CommandDropsMqtt, count);
         return;
     }
     if (source == CommandSource::Web) {
-        state_.command_drop_web_count += count;
+        state_.metrics.add(MetricId::CommandDropsWeb, count);
     }
 }
 
@@ -357,16 +409,24 @@ void AppController::applyOutputs() {
         } else {
             display_.render(state_, settings_);
         }
+        const DisplayRenderStats& render_stats = display_.renderStats();
+        MetricsRegistry& metrics = state_.metrics;
+        if (render_stats.updates != metrics.get(MetricId::DisplayUpdates)) {
+            metrics.observe(HistogramId::DisplayUpdateBytes, render_stats.last_update_bytes);
+        }
+        metrics.set(MetricId::DisplayUpdates, render_stats.updates);
+        metrics.set(MetricId::DisplayLastUpdateBytes, render_stats.last_update_bytes);
+        metrics.set(MetricId::DisplayBytes, render_stats.total_bytes);
         state_.dirty_display = false;
     }
 }
 
-void AppController::queueStatePublish() {
+void AppController::queueStatePublish(uint32_t now_ms) {
     int fan_pwm = map(state_.fan_percent, 0, 100, 0, 255);
 
-    mqtt_.enqueueStatePublish("state/fan_percent", state_.fan_percent);
-    mqtt_.enqueueStatePublish("state/fan_pwm", fan_pwm);
-    mqtt_.enqueueStatePublish("state/lights", state_.lights_on ? 1 : 0);
-    mqtt_.enqueueStatePublish("sensor/pm25", state_.pm25_smooth);
-    mqtt_.enqueueStatePublish("sensor/pm10", state_.pm10_smooth);
+    mqtt_.publishValue(MqttTopic::StateFanPercent, state_.fan_percent, now_ms);
+    mqtt_.publishValue(MqttTopic::StateFanPwm, fan_pwm, now_ms);
+    mqtt_.publishValue(MqttTopic::StateLights, state_.lights_on ? 1 : 0, now_ms);
+    mqtt_.publishValue(MqttTopic::SensorPm25, state_.pm25_smooth, now_ms);
+    mqtt_.publishValue(MqttTopic::SensorPm10, state_.pm10_smooth, now_ms);
 }
@@ -61,6 +61,9 @@ private:
     uint32_t last_report_ms_;
     uint32_t last_health_publish_ms_;
     uint32_t last_sensor_sample_ms_;
+    uint32_t last_history_sample_ms_;
+    uint32_t pm25_history_sum_;
+    uint16_t pm25_history_count_;
     uint32_t wifi_ip_visible_until_ms_;
 
     void tickDisplay(uint32_t now_ms);
@@ -76,7 +79,7 @@ private:
     void processCommands();
     void applyCommand(const Command& cmd);
     void applyOutputs();
-    void queueStatePublish();
+    void queueStatePublish(uint32_t now_ms);
 };
 
 AppController& appController();
@@ -19,6 +19,7 @@ enum class CommandType : uint8_t {
     ResetWifiSettings,
     Reboot,
     EnterDfu,
+    SetPower,
 };
 
 struct Command {
@@ -10,6 +10,20 @@ int clampPercent(int value) {
     }
     return value;
 }
+
+void powerOff(DeviceState& state) {
+    state.saved_fan_percent = state.fan_percent;
+    state.fan_percent = 0;
+    state.lights_on = false;
+}
+
+void powerOn(DeviceState& state) {
+    if (state.saved_fan_percent < 10) {
+        state.saved_fan_percent = 10;
+    }
+    state.fan_percent = state.saved_fan_percent;
+    state.lights_on = true;
+}
 }
 
 bool CommandRouter::apply(const Command& cmd, DeviceState& state) {
@@ -48,15 +62,20 @@ bool CommandRouter::apply(const Command& cmd, DeviceState& state) {
             break;
         case CommandType::TogglePower:
             if (state.fan_percent > 0) {
-                state.saved_fan_percent = state.fan_percent;
-                state.fan_percent = 0;
-                state.lights_on = false;
+                powerOff(state);
             } else {
-                if (state.saved_fan_percent < 10) {
-                    state.saved_fan_percent = 10;
-                }
-                state.fan_percent = state.saved_fan_percent;
-                state.lights_on = true;
+                powerOn(state);
+            }
+            break;
+        case CommandType::SetPower:
+            // Already in the requested state: nothing to redraw or publish.
+            if ((cmd.value != 0) == (state.fan_percent > 0)) {
+                return false;
+            }
+            if (cmd.value != 0) {
+                powerOn(state);
+            } else {
+                powerOff(state);
             }
             break;
         case CommandType::Reboot:
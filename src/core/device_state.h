@@ -1,6 +1,11 @@
 #pragma once
 
 #include "Particle.h"
+#include "metrics.h"
+#include "../util/sample_ring.h"
+
+static const size_t kPmHistoryLength = 128;
+static const uint32_t kPmHistoryIntervalMs = 30000;
 
 struct DeviceState {
     int fan_percent;
@@ -12,6 +17,7 @@ struct DeviceState {
     int pm10_raw;
     int pm25_smooth;
     int pm10_smooth;
+    SampleRing<uint16_t, kPmHistoryLength> pm25_history;
 
     bool wifi_ready;
     bool wifi_enabled;
@@ -21,13 +27,9 @@ struct DeviceState {
     uint32_t boot_ms;
     uint32_t last_sensor_packet_ms;
 
-    uint32_t wifi_reconnect_count;
-    uint32_t mqtt_reconnect_count;
-    uint32_t sensor_parse_errors;
-    uint32_t command_drop_button_count;
-    uint32_t command_drop_mqtt_count;
-    uint32_t command_drop_web_count;
-    uint32_t mqtt_publish_drop_count;
+    // Health counters, gauges and histograms; the one source for /metrics,
+    // /api/v2/state and MQTT health topics.
+    MetricsRegistry metrics;
 
     bool dirty_display;
     bool dirty_publish;
@@ -42,19 +44,14 @@ inline void initDeviceState(DeviceState& state, uint32_t now_ms) {
     state.pm10_raw = 0;
     state.pm25_smooth = 0;
     state.pm10_smooth = 0;
+    state.pm25_history.clear();
     state.wifi_ready = false;
     state.wifi_enabled = true;
     state.wifi_ip_visible = false;
     state.mqtt_connected = false;
     state.boot_ms = now_ms;
     state.last_sensor_packet_ms = now_ms;
-    state.wifi_reconnect_count = 0;
-    state.mqtt_reconnect_count = 0;
-    state.sensor_parse_errors = 0;
-    state.command_drop_button_count = 0;
-    state.command_drop_mqtt_count = 0;
-    state.command_drop_web_count = 0;
-    state.mqtt_publish_drop_count = 0;
+    state.metrics.reset();
     state.dirty_display = true;
     state.dirty_publish = true;
 }
@@ -0,0 +1,62 @@
+#include "metrics.h"
+
+namespace {
+const MetricInfo kMetricInfo[] = {
+    {"aeris_wifi_reconnects_total", nullptr, "Wi-Fi reconnects since boot.", MetricKind::Counter},
+    {"aeris_mqtt_reconnects_total", nullptr, "MQTT reconnects since boot.", MetricKind::Counter},
+    {"aeris_sensor_parse_errors_total", nullptr, "Rejected PM sensor frames.", MetricKind::Counter},
+    {"aeris_command_drops_total", "source=\"button\"", "Commands dropped on a full queue.", MetricKind::Counter},
+    {"aeris_command_drops_total", "source=\"mqtt\"", "Commands dropped on a full queue.", MetricKind::Counter},
+    {"aeris_command_drops_total", "source=\"web\"", "Commands dropped on a full queue.", MetricKind::Counter},
+    {"aeris_mqtt_publish_drops_total", nullptr, "MQTT publishes refused by the client (retried).", MetricKind::Counter},
+    {"aeris_mqtt_publishes_total", nullptr, "MQTT messages published.", MetricKind::Counter},
+    {"aeris_mqtt_offline_drops_total", nullptr, "Offline samples overwritten before replay.", MetricKind::Counter},
+    {"aeris_mqtt_commands_total", "result=\"accepted\"", "MQTT command messages received.", MetricKind::Counter},
+    {"aeris_mqtt_commands_total", "result=\"rejected\"", "MQTT command messages received.", MetricKind::Counter},
+    {"aeris_display_updates_total", nullptr, "TFT updates drawn.", MetricKind::Counter},
+    {"aeris_display_spi_bytes_total", nullptr, "Estimated TFT SPI bytes sent.", MetricKind::Counter},
+    {"aeris_http_responses_total", nullptr, "Local HTTP responses sent.", MetricKind::Counter},
+    {"aeris_http_response_bytes_total", nullptr, "Local HTTP response bytes sent.", MetricKind::Counter},
+    {"aeris_http_response_segments_total", nullptr, "Socket writes used for HTTP responses.", MetricKind::Counter},
+    {"aeris_display_last_update_bytes", nullptr, "SPI bytes of the latest TFT update.", MetricKind::Gauge},
+    {"aeris_http_last_response_bytes", nullptr, "Size of the latest HTTP response.", MetricKind::Gauge},
+    {"aeris_http_last_response_segments", nullptr, "Socket writes of the latest HTTP response.", MetricKind::Gauge},
+    {"aeris_mqtt_publish_rate", nullptr, "MQTT messages published per second (last window).", MetricKind::Gauge},
+    {"aeris_mqtt_offline_backlog", nullptr, "Offline samples waiting for replay.", MetricKind::Gauge},
+    {"aeris_heap_free_bytes", nullptr, "Free heap bytes.", MetricKind::Gauge},
+    {"aeris_heap_max_used_bytes", nullptr, "Heap high-water mark since boot.", MetricKind::Gauge},
+    {"aeris_heap_largest_free_block_bytes", nullptr, "Largest contiguous free heap block.", MetricKind::Gauge},
+    {"aeris_heap_fragmentation_percent", nullptr, "Free heap outside the largest block.", MetricKind::Gauge},
+};
+static_assert(sizeof(kMetricInfo) / sizeof(kMetricInfo[0]) == kMetricCount, "metric table out of sync");
+
+const HistogramInfo kHistogramInfo[] = {
+    {"aeris_display_update_bytes", "SPI bytes per TFT update.", {256, 1024, 4096, 16384, 65536}, 5},
+    {"aeris_http_response_bytes", "Bytes per HTTP response.", {128, 512, 1460, 4096, 16384}, 5},
+    {"aeris_mqtt_publish_latency_ms", "Time from a value becoming due to its publish.", {25, 100, 500, 2000, 10000}, 5},
+    {"aeris_mqtt_publish_call_us", "Time spent inside one MQTT publish() call.", {200, 1000, 5000, 20000, 100000}, 5},
+    {"aeris_mqtt_connect_ms", "Duration of successful MQTT connect attempts.", {250, 1000, 3000, 10000, 20000}, 5},
+};
+static_assert(sizeof(kHistogramInfo) / sizeof(kHistogramInfo[0]) == kHistogramCount, "histogram table out of sync");
+}  // namespace
+
+const MetricInfo& metricInfo(MetricId id) {
+    return kMetricInfo[static_cast<size_t>(id)];
+}
+
+const HistogramInfo& histogramInfo(HistogramId id) {
+    return kHistogramInfo[static_cast<size_t>(id)];
+}
+
+void MetricsRegistry::observe(HistogramId id, uint32_t value) {
+    const HistogramInfo& info = kHistogramInfo[static_cast<size_t>(id)];
+    Histogram& h = histograms_[static_cast<size_t>(id)];
+    // At most kHistogramMaxBounds compares, independent of registry size.
+    uint8_t bucket = 0;
+    while (bucket < info.bound_count && value > info.bounds[bucket]) {
+        ++bucket;
+    }
+    h.buckets[bucket] += 1;
+    h.count += 1;
+    h.sum += value;
+}
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Every health metric has a compile-time id; storage is a flat preallocated
+// array indexed by it, so updates are a single add or store. Names and help
+// text live in the descriptor tables in metrics.cpp, in id order.
+enum class MetricId : uint8_t {
+    WifiReconnects = 0,
+    MqttReconnects,
+    SensorParseErrors,
+    CommandDropsButton,
+    CommandDropsMqtt,
+    CommandDropsWeb,
+    MqttPublishDrops,
+    MqttPublishes,
+    MqttOfflineDrops,
+    MqttCommandsReceived,
+    MqttCommandsRejected,
+    DisplayUpdates,
+    DisplayBytes,
+    HttpResponses,
+    HttpResponseBytes,
+    HttpResponseSegments,
+    DisplayLastUpdateBytes,
+    HttpLastResponseBytes,
+    HttpLastResponseSegments,
+    MqttPublishRate,
+    MqttOfflineBacklog,
+    HeapFree,
+    HeapMaxUsed,
+    HeapLargestFreeBlock,
+    HeapFragmentation,
+    Count,
+};
+
+enum class HistogramId : uint8_t {
+    DisplayUpdateBytes = 0,
+    HttpResponseBytes,
+    MqttPublishLatencyMs,
+    MqttPublishCallUs,
+    MqttConnectMs,
+    Count,
+};
+
+enum class MetricKind : uint8_t {
+    Counter,
+    Gauge,
+};
+
+struct MetricInfo {
+    const char* name;
+    // Prometheus label set without braces, or nullptr. Consecutive entries with
+    // the same name form one metric family.
+    const char* labels;
+    const char* help;
+    MetricKind kind;
+};
+
+static const uint8_t kHistogramMaxBounds = 6;
+
+struct HistogramInfo {
+    const char* name;
+    const char* help;
+    // Upper bounds of the finite buckets, ascending; +Inf is implicit.
+    uint32_t bounds[kHistogramMaxBounds];
+    uint8_t bound_count;
+};
+
+static const size_t kMetricCount = static_cast<size_t>(MetricId::Count);
+static const size_t kHistogramCount = static_cast<size_t>(HistogramId::Count);
+
+const MetricInfo& metricInfo(MetricId id);
+const HistogramInfo& histogramInfo(HistogramId id);
+
+class MetricsRegistry {
+public:
+    MetricsRegistry() {
+        reset();
+    }
+
+    void reset() {
+        for (size_t i = 0; i < kMetricCount; ++i) {
+            values_[i] = 0;
+        }
+        for (size_t h = 0; h < kHistogramCount; ++h) {
+            for (size_t b = 0; b <= kHistogramMaxBounds; ++b) {
+                histograms_[h].buckets[b] = 0;
+            }
+            histograms_[h].count = 0;
+            histograms_[h].sum = 0;
+        }
+    }
+
+    void add(MetricId id, uint32_t n = 1) {
+        values_[static_cast<size_t>(id)] += n;
+    }
+
+    // For gauges, and for counters mirrored from a module that keeps its own tally.
+    void set(MetricId id, uint32_t value) {
+        values_[static_cast<size_t>(id)] = value;
+    }
+
+    uint32_t get(MetricId id) const {
+        return values_[static_cast<size_t>(id)];
+    }
+
+    void observe(HistogramId id, uint32_t value);
+
+    // Per-bucket (not cumulative) count; bucket == bound_count is +Inf.
+    uint32_t bucket(HistogramId id, uint8_t bucket) const {
+        return histograms_[static_cast<size_t>(id)].buckets[bucket];
+    }
+
+    uint32_t count(HistogramId id) const {
+        return histograms_[static_cast<size_t>(id)].count;
+    }
+
+    uint32_t sum(HistogramId id) const {
+        return histograms_[static_cast<size_t>(id)].sum;
+    }
+
+private:
+    struct Histogram {
+        uint32_t buckets[kHistogramMaxBounds + 1];
+        uint32_t count;
+        uint32_t sum;
+    };
+
+    uint32_t values_[kMetricCount];
+    Histogram histograms_[kHistogramCount];
+};
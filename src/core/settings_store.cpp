@@ -36,12 +36,22 @@ struct PersistentSettings {
     uint16_t fan_color;
     uint16_t pm_label_color;
     uint16_t pm_value_color;
+    uint8_t v4_tail_padding[2];  // implicit padding in v4, covered by its CRC
+
+    // v5
+    uint8_t mqtt_publish_mode;
+    uint8_t reserved[3];
 };
 
 static_assert(sizeof(PersistentSettings) == SETTINGS_SCHEMA_LENGTH,
               "Persistent settings schema size changed unexpectedly");
 static_assert(offsetof(PersistentSettings, wifi_ssid) == 12,
               "Persistent settings payload offset must stay stable");
+static_assert(offsetof(PersistentSettings, mqtt_publish_mode) == SETTINGS_SCHEMA_LENGTH_V4,
+              "v5 fields must start where the v4 record ended");
+
+const int16_t kDefaultPmY = 164;
+const int16_t kLegacyDefaultPmY = 180;  // default before schema v5
 
 int clampInt(int value, int min_v, int max_v) {
     if (value < min_v) {
@@ -74,6 +84,8 @@ void persistentToRuntime(const PersistentSettings& src, SettingsV2& dst) {
     dst.fan_color = src.fan_color;
     dst.pm_label_color = src.pm_label_color;
     dst.pm_value_color = src.pm_value_color;
+
+    dst.mqtt_publish_mode = src.mqtt_publish_mode;
 }
 
 void runtimeToPersistent(const SettingsV2& src, PersistentSettings& dst) {
@@ -97,22 +109,40 @@ void runtimeToPersistent(const SettingsV2& src, PersistentSettings& dst) {
     dst.fan_color = src.fan_color;
     dst.pm_label_color = src.pm_label_color;
     dst.pm_value_color = src.pm_value_color;
+
+    dst.mqtt_publish_mode = src.mqtt_publish_mode;
 }
 
-uint32_t calculatePersistentCrc(const PersistentSettings& settings) {
+// `length` covers the record as written by its schema version.
+uint32_t calculatePersistentCrc(const PersistentSettings& settings, size_t length) {
     PersistentSettings copy = settings;
     copy.crc32 = 0;
-    return crc32_bytes(reinterpret_cast<const uint8_t*>(&copy), sizeof(copy));
+    return crc32_bytes(reinterpret_cast<const uint8_t*>(&copy), length);
+}
+
+// A v4 record read into the v5 layout: everything up to the new fields is
+// identical, so only the tail needs defaults.
+void migrateFromV4(PersistentSettings& s) {
+    // The old pm_y default left no room for the PM trend strip below the PM
+    // block; move devices still on it to the new default. Custom values stay.
+    if (s.pm_y == kLegacyDefaultPmY) {
+        s.pm_y = kDefaultPmY;
+    }
+    memset(s.v4_tail_padding, 0, sizeof(s.v4_tail_padding));
+    s.mqtt_publish_mode = static_cast<uint8_t>(MqttPublishMode::PerTopic);
+    memset(s.reserved, 0, sizeof(s.reserved));
 }
 
 bool validatePersistent(const PersistentSettings& s) {
     if (s.magic != SETTINGS_MAGIC) {
         return false;
     }
-    if (s.version != SETTINGS_SCHEMA_VERSION) {
-        return false;
-    }
-    if (s.length != sizeof(PersistentSettings)) {
+    size_t length = 0;
+    if (s.version == SETTINGS_SCHEMA_VERSION && s.length == sizeof(PersistentSettings)) {
+        length = sizeof(PersistentSettings);
+    } else if (s.version == SETTINGS_SCHEMA_VERSION_V4 && s.length == SETTINGS_SCHEMA_LENGTH_V4) {
+        length = SETTINGS_SCHEMA_LENGTH_V4;
+    } else {
         return false;
     }
     if (!hasNullTerminator(s.wifi_ssid, sizeof(s.wifi_ssid))) {
@@ -145,7 +175,10 @@ bool validatePersistent(const PersistentSettings& s) {
     if (!(s.mqtt_enabled == 0 || s.mqtt_enabled == 1)) {
         return false;
     }
-    return s.crc32 == calculatePersistentCrc(s);
+    if (length == sizeof(PersistentSettings) && s.mqtt_publish_mode > static_cast<uint8_t>(MqttPublishMode::Aggregate)) {
+        return false;
+    }
+    return s.crc32 == calculatePersistentCrc(s, length);
 }
 }  // namespace
 
@@ -154,6 +187,10 @@ bool SettingsStore::loadOrInitialize(SettingsV2& out) {
     EEPROM.get(EEPROM_ADDR_SETTINGS, persisted);
 
     if (validatePersistent(persisted)) {
+        if (persisted.version == SETTINGS_SCHEMA_VERSION_V4) {
+            // Rewritten as v5 on the next save; nothing is written at boot.
+            migrateFromV4(persisted);
+        }
         persistentToRuntime(persisted, out);
         sanitize(out);
         return true;
@@ -172,7 +209,7 @@ bool SettingsStore::save(SettingsV2& settings) {
     persisted.magic = SETTINGS_MAGIC;
     persisted.version = SETTINGS_SCHEMA_VERSION;
     persisted.length = sizeof(PersistentSettings);
-    persisted.crc32 = calculatePersistentCrc(persisted);
+    persisted.crc32 = calculatePersistentCrc(persisted, sizeof(persisted));
 
     EEPROM.put(EEPROM_ADDR_SETTINGS, persisted);
     return true;
@@ -195,11 +232,13 @@ void SettingsStore::applyDefaults(SettingsV2& settings) {
     settings.fan_y = 70;
     settings.pm_font_size = 3;
     settings.pm_x = 60;
-    settings.pm_y = 180;
+    settings.pm_y = kDefaultPmY;
 
     settings.fan_color = ST77XX_WHITE;
     settings.pm_label_color = ST77XX_CYAN;
     settings.pm_value_color = ST77XX_WHITE;
+
+    settings.mqtt_publish_mode = static_cast<uint8_t>(MqttPublishMode::PerTopic);
     sanitize(settings);
 }
 
@@ -223,6 +262,9 @@ void SettingsStore::sanitize(SettingsV2& s) {
 
     s.mqtt_port = static_cast<uint16_t>(clampInt(s.mqtt_port, 1, 65535));
     s.mqtt_enabled = s.mqtt_enabled ? 1 : 0;
+    if (s.mqtt_publish_mode > static_cast<uint8_t>(MqttPublishMode::Aggregate)) {
+        s.mqtt_publish_mode = static_cast<uint8_t>(MqttPublishMode::PerTopic);
+    }
 
     s.fan_font_size = static_cast<int16_t>(clampInt(s.fan_font_size, 1, 12));
     s.pm_font_size = static_cast<int16_t>(clampInt(s.pm_font_size, 1, 12));
@@ -3,9 +3,19 @@
 #include "Particle.h"
 
 static const uint32_t SETTINGS_MAGIC = 0x41414952UL;  // 'AAIR'
-static const uint16_t SETTINGS_SCHEMA_VERSION = 4;
+static const uint16_t SETTINGS_SCHEMA_VERSION = 5;
 static const int EEPROM_ADDR_SETTINGS = 0;
-static const size_t SETTINGS_SCHEMA_LENGTH = 356;
+static const size_t SETTINGS_SCHEMA_LENGTH = 360;
+// v4 records are a byte prefix of v5 and are migrated on load.
+static const uint16_t SETTINGS_SCHEMA_VERSION_V4 = 4;
+static const size_t SETTINGS_SCHEMA_LENGTH_V4 = 356;
+
+// How MQTT values go out: one topic per value, or one JSON document per
+// category (state, sensor, health).
+enum class MqttPublishMode : uint8_t {
+    PerTopic = 0,
+    Aggregate = 1,
+};
 
 struct SettingsV2 {
     char wifi_ssid[64];
@@ -28,6 +38,8 @@ struct SettingsV2 {
     uint16_t fan_color;
     uint16_t pm_label_color;
     uint16_t pm_value_color;
+
+    uint8_t mqtt_publish_mode;  // MqttPublishMode
 };
 
 class SettingsStore {
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Particle.h"
+#include "Adafruit_ST7789.h"
+
+struct DisplayRenderStats {
+    uint32_t updates;
+    uint32_t last_update_windows;
+    uint32_t last_update_pixels;
+    uint32_t last_update_bytes;
+    uint32_t total_bytes;
+};
+
+// Every GFX primitive on the SPITFT path opens an address window and then
+// streams exactly w*h RGB565 pixels into it, so counting windows gives the
+// wire cost of a frame update without touching the drawing code.
+class CountingST7789 : public Adafruit_ST7789 {
+public:
+    // CASET + RASET + RAMWR command bytes plus two 32-bit range arguments.
+    static const uint32_t kWindowOverheadBytes = 11;
+
+    CountingST7789(int8_t cs, int8_t dc, int8_t rst)
+        : Adafruit_ST7789(cs, dc, rst), windows_(0), pixels_(0) {}
+
+    void setAddrWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h) override {
+        windows_ += 1;
+        pixels_ += static_cast<uint32_t>(w) * h;
+        Adafruit_ST7789::setAddrWindow(x, y, w, h);
+    }
+
+    uint32_t windows() const {
+        return windows_;
+    }
+
+    uint32_t pixels() const {
+        return pixels_;
+    }
+
+    uint32_t spiBytes() const {
+        return windows_ * kWindowOverheadBytes + pixels_ * 2;
+    }
+
+private:
+    uint32_t windows_;
+    uint32_t pixels_;
+};
@@ -20,6 +20,13 @@ constexpr float kWifiArcStepDeg = 2.0f;
 constexpr uint16_t kWifiOkColor = ST77XX_GREEN;
 // This panel wiring/color-order renders RGB565 blue as visible red on-device.
 constexpr uint16_t kWifiAlertColor = ST77XX_BLUE;
+// Same panel color-order swap: RGB565 cyan shows as yellow on-device.
+constexpr uint16_t kPmHistoryMidColor = ST77XX_CYAN;
+constexpr int kPmHistoryGap = 4;
+constexpr int kPmHistoryMaxHeight = 24;
+constexpr int kPmHistoryMinHeight = 6;
+constexpr int kPmHistoryColumnW = 2;
+constexpr int kPmHistoryFullScale = 100;  // ug/m3 mapped to full bar height
 constexpr int kSetupTextX = 26;
 constexpr int kSetupTitleY = 50;
 constexpr int kSetupConnectY = 100;
@@ -284,6 +291,9 @@ DisplayDriver::DisplayDriver(int cs, int dc, int rst, int bl_pin)
     : tft_(cs, dc, rst),
       bl_pin_(bl_pin),
       screen_light_on_(false),
+      update_start_windows_(0),
+      update_start_pixels_(0),
+      update_start_bytes_(0),
       last_fan_percent_(-1),
       last_pm25_(-1),
       last_pm10_(-1),
@@ -293,11 +303,17 @@ DisplayDriver::DisplayDriver(int cs, int dc, int rst, int bl_pin)
       last_wifi_status_x_(0),
       last_wifi_status_y_(0),
       last_wifi_status_w_(0),
+      last_history_total_(0),
+      history_x_(0),
+      history_y_(0),
+      history_h_(0),
+      history_cols_(0),
       has_drawn_(false),
       setup_screen_drawn_(false) {
     last_wifi_status_text_[0] = '\0';
     last_setup_ssid_[0] = '\0';
     last_setup_ip_[0] = '\0';
+    memset(&stats_, 0, sizeof(stats_));
 }
 
 void DisplayDriver::init() {
@@ -340,6 +356,28 @@ void DisplayDriver::setScreenLight(bool on) {
     digitalWrite(bl_pin_, on ? HIGH : LOW);
 }
 
+const DisplayRenderStats& DisplayDriver::renderStats() const {
+    return stats_;
+}
+
+void DisplayDriver::beginUpdate() {
+    update_start_windows_ = tft_.windows();
+    update_start_pixels_ = tft_.pixels();
+    update_start_bytes_ = tft_.spiBytes();
+}
+
+void DisplayDriver::endUpdate() {
+    uint32_t bytes = tft_.spiBytes() - update_start_bytes_;
+    if (bytes == 0) {
+        return;
+    }
+    stats_.updates += 1;
+    stats_.last_update_windows = tft_.windows() - update_start_windows_;
+    stats_.last_update_pixels = tft_.pixels() - update_start_pixels_;
+    stats_.last_update_bytes = bytes;
+    stats_.total_bytes += bytes;
+}
+
 void DisplayDriver::resetRenderCache() {
     has_drawn_ = false;
     setup_screen_drawn_ = false;
@@ -353,6 +391,8 @@ void DisplayDriver::resetRenderCache() {
     last_wifi_status_x_ = 0;
     last_wifi_status_y_ = 0;
     last_wifi_status_w_ = 0;
+    last_history_total_ = 0;
+    history_cols_ = 0;
     last_setup_ssid_[0] = '\0';
     last_setup_ip_[0] = '\0';
 }
@@ -367,6 +407,7 @@ void DisplayDriver::renderSetupScreen(const char* softap_ssid, const char* softa
         return;
     }
 
+    beginUpdate();
     tft_.fillScreen(ST77XX_BLACK);
     tft_.setTextColor(ST77XX_WHITE);
     tft_.setTextSize(3);
@@ -387,15 +428,18 @@ void DisplayDriver::renderSetupScreen(const char* softap_ssid, const char* softa
     last_setup_ip_[sizeof(last_setup_ip_) - 1] = '\0';
     setup_screen_drawn_ = true;
     has_drawn_ = false;
+    endUpdate();
 }
 
 void DisplayDriver::renderConnectingScreen() {
+    beginUpdate();
     setup_screen_drawn_ = false;
     tft_.fillScreen(ST77XX_BLACK);
     tft_.setTextColor(ST77XX_WHITE);
     tft_.setTextSize(2);
     tft_.setCursor(10, 100);
     tft_.println("Connecting...");
+    endUpdate();
 }
 
 void DisplayDriver::render(const DeviceState& state, const SettingsV2& settings) {
@@ -404,6 +448,7 @@ void DisplayDriver::render(const DeviceState& state, const SettingsV2& settings)
     }
 
     setup_screen_drawn_ = false;
+    beginUpdate();
 
     if (!has_drawn_) {
         tft_.fillScreen(kMainBgColor);
@@ -418,6 +463,8 @@ void DisplayDriver::render(const DeviceState& state, const SettingsV2& settings)
         last_wifi_status_x_ = 0;
         last_wifi_status_y_ = 0;
         last_wifi_status_w_ = 0;
+        last_history_total_ = 0;
+        history_cols_ = 0;
     }
 
     int line_height = 8 * settings.pm_font_size;
@@ -546,4 +593,76 @@ void DisplayDriver::render(const DeviceState& state, const SettingsV2& settings)
         }
         drawPmLine(tft_, pm_x, pm10_y, state.pm10_smooth, "10", settings);
     }
+
+    if (last_history_total_ != state.pm25_history.total() || history_cols_ == 0) {
+        int pm_x = clampInt(settings.pm_x + kPmBlockXOffset, 0, tft_.width() - 1);
+        drawPmHistory(state, pm_x, pm10_y + line_height + kPmHistoryGap);
+    }
+    endUpdate();
+}
+
+void DisplayDriver::drawPmHistory(const DeviceState& state, int x, int y) {
+    int h = tft_.height() - y;
+    if (h > kPmHistoryMaxHeight) {
+        h = kPmHistoryMaxHeight;
+    }
+    int cols = (tft_.width() - x) / kPmHistoryColumnW;
+    if (cols > static_cast<int>(kPmHistoryLength)) {
+        cols = static_cast<int>(kPmHistoryLength);
+    }
+    if (h < kPmHistoryMinHeight || cols < 2) {
+        last_history_total_ = state.pm25_history.total();
+        return;
+    }
+
+    const uint32_t total = state.pm25_history.total();
+    // One column stays blank as the sweep cursor, so cols - 1 samples are visible.
+    const uint32_t visible = static_cast<uint32_t>(cols - 1);
+    uint32_t first = last_history_total_;
+
+    bool layout_changed = (history_cols_ != cols || history_x_ != x || history_y_ != y || history_h_ != h);
+    if (layout_changed || total - last_history_total_ > visible) {
+        if (history_cols_ > 0) {
+            tft_.fillRect(history_x_, history_y_, history_cols_ * kPmHistoryColumnW, history_h_, kMainBgColor);
+        }
+        history_x_ = x;
+        history_y_ = y;
+        history_h_ = h;
+        history_cols_ = cols;
+        tft_.fillRect(x, y, cols * kPmHistoryColumnW, h, kMainBgColor);
+        first = (total > visible) ? (total - visible) : 0;
+    }
+
+    // The ST7789 scroll window spans whole panel lines, which in this landscape
+    // orientation would drag the fan/PM text along; sweep in place instead so
+    // each new sample costs a single column write.
+    for (uint32_t seq = first; seq < total; ++seq) {
+        drawPmHistoryColumn(state, seq);
+    }
+    if (total > 0) {
+        int cursor_x = history_x_ + static_cast<int>(total % history_cols_) * kPmHistoryColumnW;
+        tft_.fillRect(cursor_x, history_y_, kPmHistoryColumnW, history_h_, kMainBgColor);
+    }
+    last_history_total_ = total;
+}
+
+void DisplayDriver::drawPmHistoryColumn(const DeviceState& state, uint32_t seq) {
+    const int value = state.pm25_history.at(seq);
+    const int col_x = history_x_ + static_cast<int>(seq % history_cols_) * kPmHistoryColumnW;
+
+    int bar_h = (clampInt(value, 0, kPmHistoryFullScale) * history_h_) / kPmHistoryFullScale;
+    if (bar_h < 1) {
+        bar_h = 1;
+    }
+    uint16_t color = kWifiOkColor;
+    if (value > 35) {
+        color = kWifiAlertColor;
+    } else if (value > 12) {
+        color = kPmHistoryMidColor;
+    }
+
+    if (bar_h < history_h_) {
+        tft_.fillRect(col_x, history_y_, kPmHistoryColumnW, history_h_ - bar_h, kMainBgColor);
+    }
+    tft_.fillRect(col_x, history_y_ + history_h_ - bar_h, kPmHistoryColumnW, bar_h, color);
 }
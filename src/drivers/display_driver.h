@@ -2,6 +2,7 @@
 
 #include "Particle.h"
 #include "Adafruit_ST7789.h"
+#include "counting_st7789.h"
 #include "../core/device_state.h"
 #include "../core/settings_store.h"
 
@@ -16,15 +17,25 @@ public:
     void render(const DeviceState& state, const SettingsV2& settings);
     void setLights(bool on);
     void setScreenLight(bool on);
+    const DisplayRenderStats& renderStats() const;
 
 private:
     void initPanel();
     void resetRenderCache();
+    void beginUpdate();
+    void endUpdate();
+    void drawPmHistory(const DeviceState& state, int x, int y);
+    void drawPmHistoryColumn(const DeviceState& state, uint32_t seq);
 
-    Adafruit_ST7789 tft_;
+    CountingST7789 tft_;
     int bl_pin_;
     bool screen_light_on_;
 
+    DisplayRenderStats stats_;
+    uint32_t update_start_windows_;
+    uint32_t update_start_pixels_;
+    uint32_t update_start_bytes_;
+
     int last_fan_percent_;
     int last_pm25_;
     int last_pm10_;
@@ -35,6 +46,11 @@ private:
     int last_wifi_status_x_;
     int last_wifi_status_y_;
     int last_wifi_status_w_;
+    uint32_t last_history_total_;
+    int history_x_;
+    int history_y_;
+    int history_h_;
+    int history_cols_;
     bool has_drawn_;
     bool setup_screen_drawn_;
     char last_setup_ssid_[40];
@@ -78,7 +78,7 @@ void SensorDriver::parseByte(uint8_t b, DeviceState& state, uint32_t now_ms) {
         state.pm10_raw = (frame_[14] << 8) + frame_[15];
         state.last_sensor_packet_ms = now_ms;
     } else {
-        state.sensor_parse_errors += 1;
+        state.metrics.add(MetricId::SensorParseErrors);
     }
 
     in_frame_ = false;
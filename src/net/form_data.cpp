@@ -0,0 +1,225 @@
+#include "form_data.h"
+
+#include "../util/const_hash.h"
+
+#include <string.h>
+
+namespace {
+int hexToInt(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+// Decoded output never outgrows its input, so it can overwrite the source.
+void urlDecodeInPlace(char* s) {
+    char* out = s;
+    for (const char* in = s; *in != '\0'; ++in) {
+        char c = *in;
+        if (c == '+') {
+            *out++ = ' ';
+        } else if (c == '%' && in[1] != '\0' && in[2] != '\0') {
+            int hi = hexToInt(in[1]);
+            int lo = hexToInt(in[2]);
+            if (hi >= 0 && lo >= 0) {
+                *out++ = static_cast<char>((hi << 4) | lo);
+                in += 2;
+            } else {
+                *out++ = c;
+            }
+        } else {
+            *out++ = c;
+        }
+    }
+    *out = '\0';
+}
+}  // namespace
+
+// Names in FormField order; index 0 is FormField::Unknown.
+constexpr const char* kFormFieldNames[] = {
+    "",
+    "wifi_ssid",
+    "wifi_pass",
+    "mqtt_host",
+    "mqtt_port",
+    "mqtt_enabled",
+    "mqtt_user",
+    "mqtt_pass",
+    "device_id",
+    "mqtt_topic_root",
+    "mqtt_publish_mode",
+    "fan_font_size",
+    "fan_x",
+    "fan_y",
+    "pm_font_size",
+    "pm_x",
+    "pm_y",
+    "fan_color",
+    "pm_label_color",
+    "pm_value_color",
+    "fan_percent",
+    "lights",
+    "screen_light",
+    "s",
+    "p",
+};
+static_assert(sizeof(kFormFieldNames) / sizeof(kFormFieldNames[0]) == static_cast<size_t>(FormField::Count),
+              "form field name table out of sync");
+
+// Case labels are the compile-time hashes of the known names, so any collision
+// inside the set fails the build as a duplicate case; the compare rejects
+// unknown keys that happen to share a hash.
+#define FORM_FIELD_CASE(field)                                      \
+    case constHash(kFormFieldNames[static_cast<uint8_t>(field)]):  \
+        return spanEquals(name, len, kFormFieldNames[static_cast<uint8_t>(field)]) ? (field) : FormField::Unknown
+
+FormField formFieldFromName(const char* name, size_t len) {
+    switch (hashSpan(name, len)) {
+        FORM_FIELD_CASE(FormField::WifiSsid);
+        FORM_FIELD_CASE(FormField::WifiPass);
+        FORM_FIELD_CASE(FormField::MqttHost);
+        FORM_FIELD_CASE(FormField::MqttPort);
+        FORM_FIELD_CASE(FormField::MqttEnabled);
+        FORM_FIELD_CASE(FormField::MqttUser);
+        FORM_FIELD_CASE(FormField::MqttPass);
+        FORM_FIELD_CASE(FormField::DeviceId);
+        FORM_FIELD_CASE(FormField::MqttTopicRoot);
+        FORM_FIELD_CASE(FormField::MqttPublishMode);
+        FORM_FIELD_CASE(FormField::FanFontSize);
+        FORM_FIELD_CASE(FormField::FanX);
+        FORM_FIELD_CASE(FormField::FanY);
+        FORM_FIELD_CASE(FormField::PmFontSize);
+        FORM_FIELD_CASE(FormField::PmX);
+        FORM_FIELD_CASE(FormField::PmY);
+        FORM_FIELD_CASE(FormField::FanColor);
+        FORM_FIELD_CASE(FormField::PmLabelColor);
+        FORM_FIELD_CASE(FormField::PmValueColor);
+        FORM_FIELD_CASE(FormField::FanPercent);
+        FORM_FIELD_CASE(FormField::Lights);
+        FORM_FIELD_CASE(FormField::ScreenLight);
+        FORM_FIELD_CASE(FormField::SetupSsid);
+        FORM_FIELD_CASE(FormField::SetupPass);
+        default:
+            return FormField::Unknown;
+    }
+}
+
+const char* formFieldName(FormField field) {
+    return kFormFieldNames[static_cast<uint8_t>(field)];
+}
+
+#undef FORM_FIELD_CASE
+
+FormData::FormData() {
+    for (uint8_t i = 0; i < kFieldCount; ++i) {
+        values_[i] = nullptr;
+        decoded_[i] = false;
+    }
+}
+
+void FormData::parse(char* data) {
+    if (data == nullptr) {
+        return;
+    }
+
+    char* p = data;
+    while (*p == '?') {
+        ++p;
+    }
+    while (*p != '\0') {
+        char* key = p;
+        char* value = nullptr;
+        while (*p != '\0' && *p != '&' && *p != '=') {
+            ++p;
+        }
+        size_t key_len = static_cast<size_t>(p - key);
+        if (*p == '=') {
+            value = ++p;
+            while (*p != '\0' && *p != '&') {
+                ++p;
+            }
+        }
+        bool at_end = (*p == '\0');
+        *p = '\0';
+
+        if (value != nullptr && key_len > 0) {
+            uint8_t index = static_cast<uint8_t>(formFieldFromName(key, key_len));
+            // First occurrence wins, matching the old per-key scan.
+            if (index != 0 && values_[index] == nullptr) {
+                values_[index] = value;
+            }
+        }
+        if (at_end) {
+            break;
+        }
+        ++p;
+    }
+}
+
+bool FormData::has(FormField field) const {
+    return values_[static_cast<uint8_t>(field)] != nullptr;
+}
+
+const char* FormData::get(FormField field) {
+    uint8_t index = static_cast<uint8_t>(field);
+    char* value = values_[index];
+    if (value != nullptr && !decoded_[index]) {
+        urlDecodeInPlace(value);
+        decoded_[index] = true;
+    }
+    return value;
+}
+
+FormStreamParser::FormStreamParser() : sink_(nullptr), ctx_(nullptr), len_(0), truncated_(false) {}
+
+void FormStreamParser::begin(FieldSink sink, void* ctx) {
+    sink_ = sink;
+    ctx_ = ctx;
+    len_ = 0;
+    truncated_ = false;
+}
+
+void FormStreamParser::feed(const char* data, size_t len) {
+    while (len > 0) {
+        const char* amp = static_cast<const char*>(memchr(data, '&', len));
+        size_t run = (amp != nullptr) ? static_cast<size_t>(amp - data) : len;
+        size_t room = kMaxPairLength - len_;
+        size_t copy = (run < room) ? run : room;
+        memcpy(pair_ + len_, data, copy);
+        len_ += copy;
+        if (copy < run) {
+            truncated_ = true;
+        }
+        if (amp == nullptr) {
+            return;
+        }
+        emitPair();
+        data = amp + 1;
+        len -= run + 1;
+    }
+}
+
+void FormStreamParser::finish() {
+    emitPair();
+}
+
+void FormStreamParser::emitPair() {
+    pair_[len_] = '\0';
+    char* eq = strchr(pair_, '=');
+    if (eq != nullptr && eq != pair_ && sink_ != nullptr) {
+        FormField field = formFieldFromName(pair_, static_cast<size_t>(eq - pair_));
+        if (field != FormField::Unknown) {
+            urlDecodeInPlace(eq + 1);
+            sink_(ctx_, field, eq + 1, truncated_);
+        }
+    }
+    len_ = 0;
+    truncated_ = false;
+}
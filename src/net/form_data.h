@@ -0,0 +1,83 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Every form/query key the firmware understands. Keys outside this set are skipped.
+enum class FormField : uint8_t {
+    Unknown = 0,
+    WifiSsid,
+    WifiPass,
+    MqttHost,
+    MqttPort,
+    MqttEnabled,
+    MqttUser,
+    MqttPass,
+    DeviceId,
+    MqttTopicRoot,
+    MqttPublishMode,
+    FanFontSize,
+    FanX,
+    FanY,
+    PmFontSize,
+    PmX,
+    PmY,
+    FanColor,
+    PmLabelColor,
+    PmValueColor,
+    FanPercent,
+    Lights,
+    ScreenLight,
+    SetupSsid,
+    SetupPass,
+    Count,
+};
+
+FormField formFieldFromName(const char* name, size_t len);
+const char* formFieldName(FormField field);
+
+// Tokenizes an application/x-www-form-urlencoded buffer in one pass, in place.
+// Values are URL-decoded on first access, also in place, so the buffer handed
+// to parse() must stay alive and writable while the form is in use.
+class FormData {
+public:
+    FormData();
+
+    void parse(char* data);
+    bool has(FormField field) const;
+    // Returns nullptr when the field is absent; an empty string when present but blank.
+    const char* get(FormField field);
+
+private:
+    static const uint8_t kFieldCount = static_cast<uint8_t>(FormField::Count);
+
+    char* values_[kFieldCount];
+    bool decoded_[kFieldCount];
+};
+
+// Incremental variant for bodies that arrive in chunks: bytes are collected one
+// key=value pair at a time and each known field is handed to the sink, already
+// URL-decoded, as soon as its terminating '&' (or finish()) is seen. Pairs longer
+// than kMaxPairLength are cut short and reported with `truncated` set.
+class FormStreamParser {
+public:
+    typedef void (*FieldSink)(void* ctx, FormField field, const char* value, bool truncated);
+
+    // Fits a fully percent-encoded 63-character value behind the longest key.
+    static const size_t kMaxPairLength = 224;
+
+    FormStreamParser();
+
+    void begin(FieldSink sink, void* ctx);
+    void feed(const char* data, size_t len);
+    void finish();
+
+private:
+    void emitPair();
+
+    FieldSink sink_;
+    void* ctx_;
+    char pair_[kMaxPairLength + 1];
+    size_t len_;
+    bool truncated_;
+};
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "../core/device_state.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// Prometheus text exposition (format 0.0.4) of the metrics registry plus a few
+// live state gauges. Templated on the sink so the same pass can first measure
+// Content-Length and then stream into the response.
+template <typename Sink>
+class MetricsExposition {
+public:
+    explicit MetricsExposition(Sink& sink) : sink_(sink) {}
+
+    void write(const DeviceState& state, uint32_t now_ms) {
+        gauge("aeris_uptime_seconds", "Seconds since boot.", (now_ms - state.boot_ms) / 1000);
+        gauge("aeris_fan_percent", "Fan duty in percent.", clampUnsigned(state.fan_percent));
+        gauge("aeris_pm25_ugm3", "Smoothed PM2.5 in ug/m3.", clampUnsigned(state.pm25_smooth));
+        gauge("aeris_pm10_ugm3", "Smoothed PM10 in ug/m3.", clampUnsigned(state.pm10_smooth));
+        gauge("aeris_wifi_ready", "1 when Wi-Fi has an IP.", state.wifi_ready ? 1 : 0);
+        gauge("aeris_mqtt_connected", "1 when the MQTT session is up.", state.mqtt_connected ? 1 : 0);
+
+        const MetricsRegistry& metrics = state.metrics;
+        const char* family = nullptr;
+        for (size_t i = 0; i < kMetricCount; ++i) {
+            MetricId id = static_cast<MetricId>(i);
+            const MetricInfo& info = metricInfo(id);
+            if (family == nullptr || strcmp(family, info.name) != 0) {
+                header(info.name, info.help, (info.kind == MetricKind::Counter) ? "counter" : "gauge");
+                family = info.name;
+            }
+            sample(info.name, "", info.labels, metrics.get(id));
+        }
+
+        for (size_t i = 0; i < kHistogramCount; ++i) {
+            HistogramId id = static_cast<HistogramId>(i);
+            const HistogramInfo& info = histogramInfo(id);
+            header(info.name, info.help, "histogram");
+            uint32_t cumulative = 0;
+            char le[20];
+            for (uint8_t b = 0; b < info.bound_count; ++b) {
+                cumulative += metrics.bucket(id, b);
+                snprintf(le, sizeof(le), "le=\"%lu\"", static_cast<unsigned long>(info.bounds[b]));
+                sample(info.name, "_bucket", le, cumulative);
+            }
+            cumulative += metrics.bucket(id, info.bound_count);
+            sample(info.name, "_bucket", "le=\"+Inf\"", cumulative);
+            sample(info.name, "_sum", nullptr, metrics.sum(id));
+            sample(info.name, "_count", nullptr, metrics.count(id));
+        }
+    }
+
+private:
+    static uint32_t clampUnsigned(int value) {
+        return (value < 0) ? 0 : static_cast<uint32_t>(value);
+    }
+
+    void text(const char* s) {
+        sink_.write(s, strlen(s));
+    }
+
+    void header(const char* name, const char* help, const char* type) {
+        text("# HELP ");
+        text(name);
+        text(" ");
+        text(help);
+        text("\n# TYPE ");
+        text(name);
+        text(" ");
+        text(type);
+        text("\n");
+    }
+
+    void sample(const char* name, const char* suffix, const char* labels, uint32_t value) {
+        text(name);
+        text(suffix);
+        if (labels != nullptr) {
+            text("{");
+            text(labels);
+            text("}");
+        }
+        char number[16];
+        int len = snprintf(number, sizeof(number), " %lu\n", static_cast<unsigned long>(value));
+        sink_.write(number, static_cast<size_t>(len));
+    }
+
+    void gauge(const char* name, const char* help, uint32_t value) {
+        header(name, help, "gauge");
+        sample(name, "", nullptr, value);
+    }
+
+    Sink& sink_;
+};
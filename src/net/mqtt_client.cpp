@@ -1,9 +1,12 @@
 #include "mqtt_client.h"
 
+#include "../util/const_hash.h"
+#include "../util/json_writer.h"
 #include "../util/parse_int.h"
 #include "../util/string_safety.h"
 #include "../util/topic_validation.h"
 
+#include <new>
 #include <stdio.h>
 #include <string.h>
 
@@ -12,6 +15,172 @@ const uint32_t kReconnectBaseIntervalMs = 3000;
 const uint8_t kReconnectBackoffMaxShift = 5;
 const uint8_t kSuspendAfterFailStreak = 4;
 const uint32_t kSuspendDurationMs = 300000;  // 5 min
+// Deadlines for one stage of an attempt. A stage past its deadline counts as a
+// failed attempt for backoff; the worker still finishes it in the background.
+const uint32_t kResolveTimeoutMs = 10000;
+const uint32_t kConnectTimeoutMs = 20000;
+
+// A full state+health burst (13 topics) drains in about 2 ticks at the defaults.
+const uint8_t kDefaultPublishBurst = 8;
+const uint16_t kDefaultPublishRatePerS = 40;
+const uint32_t kPublishBackoffBaseMs = 50;
+const uint8_t kPublishBackoffMaxShift = 4;  // 800 ms
+const uint32_t kPublishRateWindowMs = 1000;
+
+// Published values are grouped by category; in aggregate mode a group goes
+// out as one JSON document on "<root>/<group>".
+constexpr const char* kGroupNames[] = {"state", "sensor", "health"};
+// Topics outside the value groups: the command wildcard and offline replay.
+constexpr char kCommandGroup[] = "cmd";
+constexpr char kHistoryGroup[] = "history";
+
+struct TopicKey {
+    uint8_t group;     // index into kGroupNames
+    const char* name;  // "<root>/<group>/<name>", and the member name in the document
+    // Default deadband: absolute units and percent of the last sent value.
+    uint16_t deadband_abs;
+    uint8_t deadband_pct;
+};
+
+// In MqttTopic order. PM readings jitter by a few ug/m3 between reports, and
+// uptime changes on every health round, so those rely on the heartbeat.
+constexpr TopicKey kTopicKeys[] = {
+    {0, "fan_percent", 0, 0},
+    {0, "fan_pwm", 0, 0},
+    {0, "lights", 0, 0},
+    {1, "pm25", 2, 10},
+    {1, "pm10", 2, 10},
+    {2, "uptime_s", 0xFFFF, 0},
+    {2, "wifi_reconnect_count", 0, 0},
+    {2, "mqtt_reconnect_count", 0, 0},
+    {2, "sensor_parse_errors", 0, 0},
+    {2, "command_drop_button_count", 0, 0},
+    {2, "command_drop_mqtt_count", 0, 0},
+    {2, "command_drop_web_count", 0, 0},
+    {2, "mqtt_publish_drop_count", 0, 0},
+};
+constexpr size_t kTopicKeyCount = sizeof(kTopicKeys) / sizeof(kTopicKeys[0]);
+static_assert(kTopicKeyCount == static_cast<size_t>(MqttTopic::Count), "topic key table out of sync");
+constexpr size_t kGroupNameCount = sizeof(kGroupNames) / sizeof(kGroupNames[0]);
+
+constexpr size_t constLength(const char* s) {
+    return (*s == '\0') ? 0 : 1 + constLength(s + 1);
+}
+
+// Bytes each pooled topic adds after "<root>/": "<group>/<key>" per value,
+// "<group>" per aggregate document.
+constexpr size_t valueSuffixBytes(size_t i) {
+    return (i == kTopicKeyCount)
+               ? 0
+               : constLength(kGroupNames[kTopicKeys[i].group]) + 1 + constLength(kTopicKeys[i].name) +
+                     valueSuffixBytes(i + 1);
+}
+constexpr size_t groupSuffixBytes(size_t i) {
+    return (i == kGroupNameCount) ? 0 : constLength(kGroupNames[i]) + groupSuffixBytes(i + 1);
+}
+// Plus "cmd/#" and "history".
+constexpr size_t kTopicSuffixBytes =
+    valueSuffixBytes(0) + groupSuffixBytes(0) + (sizeof(kCommandGroup) + 1) + (sizeof(kHistoryGroup) - 1);
+
+const uint32_t kDefaultHeartbeatIntervalMs = 300000;  // 5 min
+
+// Largest aggregate document (health, all values 10 digits) is under 300 bytes.
+const size_t kAggregatePayloadSize = 320;
+// Library default is 255, too small for a health or history document plus its topic.
+const int kMaxPacketSize = 512;
+
+// Offline capture runs at the PM history cadence; replay sends this many
+// samples per history message, each costing one pacing token.
+const uint32_t kOfflineCaptureIntervalMs = kPmHistoryIntervalMs;
+const size_t kHistoryBatchSamples = 8;
+// Header plus 8 rows of [uptime_s,pm25,pm10,fan,lights] at their widest.
+const size_t kHistoryPayloadSize = 384;
+
+// Payload parsers for inbound commands; the range comes from the table entry.
+bool parseRangePayload(const char* payload, int min_value, int max_value, int& out) {
+    return parseIntStrict(payload, min_value, max_value, out);
+}
+
+// 0/1 plus the on/off spelling most home-automation bridges send.
+bool parseSwitchPayload(const char* payload, int min_value, int max_value, int& out) {
+    if (strcmp(payload, "on") == 0 || strcmp(payload, "ON") == 0) {
+        out = 1;
+        return true;
+    }
+    if (strcmp(payload, "off") == 0 || strcmp(payload, "OFF") == 0) {
+        out = 0;
+        return true;
+    }
+    return parseIntStrict(payload, min_value, max_value, out);
+}
+
+struct CommandTopic {
+    const char* suffix;  // below "<root>/cmd/"
+    CommandType type;
+    int min_value;
+    int max_value;
+    bool (*parse)(const char* payload, int min_value, int max_value, int& out);
+};
+
+// Index into kCommandTopics; used only to name the case labels below.
+enum CommandTopicId : uint8_t {
+    kCmdFanPercent = 0,
+    kCmdFanAdjust,
+    kCmdLights,
+    kCmdScreenLight,
+    kCmdPower,
+    kCmdReboot,
+    kCmdCount,
+};
+
+constexpr CommandTopic kCommandTopics[] = {
+    {"fan_percent", CommandType::SetFanPercent, 0, 100, &parseRangePayload},
+    {"fan_adjust", CommandType::AdjustFanPercent, -100, 100, &parseRangePayload},
+    {"lights", CommandType::SetLights, 0, 1, &parseSwitchPayload},
+    {"screen_light", CommandType::SetScreenLight, 0, 1, &parseSwitchPayload},
+    {"power", CommandType::SetPower, 0, 1, &parseSwitchPayload},
+    // Payload must be exactly 1, so a stray empty or 0 message cannot reboot.
+    {"reboot", CommandType::Reboot, 1, 1, &parseRangePayload},
+};
+static_assert(sizeof(kCommandTopics) / sizeof(kCommandTopics[0]) == kCmdCount, "command topic table out of sync");
+
+// Same scheme as form field lookup: case labels are compile-time hashes of the
+// suffixes, so a collision fails the build and lookup cost does not grow with
+// the table. The compare rejects unknown suffixes sharing a hash.
+#define COMMAND_TOPIC_CASE(id)                  \
+    case constHash(kCommandTopics[id].suffix):  \
+        return spanEquals(suffix, len, kCommandTopics[id].suffix) ? &kCommandTopics[id] : nullptr
+
+const CommandTopic* findCommandTopic(const char* suffix, size_t len) {
+    switch (hashSpan(suffix, len)) {
+        COMMAND_TOPIC_CASE(kCmdFanPercent);
+        COMMAND_TOPIC_CASE(kCmdFanAdjust);
+        COMMAND_TOPIC_CASE(kCmdLights);
+        COMMAND_TOPIC_CASE(kCmdScreenLight);
+        COMMAND_TOPIC_CASE(kCmdPower);
+        COMMAND_TOPIC_CASE(kCmdReboot);
+        default:
+            return nullptr;
+    }
+}
+
+#undef COMMAND_TOPIC_CASE
+
+// Formats without printf; `out` must hold 12 bytes.
+void formatInt32(int32_t value, char* out) {
+    char digits[11];
+    size_t pos = sizeof(digits);
+    uint32_t magnitude = (value < 0) ? 0U - static_cast<uint32_t>(value) : static_cast<uint32_t>(value);
+    do {
+        digits[--pos] = static_cast<char>('0' + (magnitude % 10));
+        magnitude /= 10;
+    } while (magnitude != 0);
+    if (value < 0) {
+        *out++ = '-';
+    }
+    memcpy(out, digits + pos, sizeof(digits) - pos);
+    out[sizeof(digits) - pos] = '\0';
+}
 
 struct MqttCallbackRouter {
     void (*handler)(void* ctx, char* topic, uint8_t* payload, unsigned int length);
@@ -30,27 +199,56 @@ void mqttCallbackBridge(char* topic, uint8_t* payload, unsigned int length) {
 
 MqttClient::MqttClient()
     : client_(nullptr),
+      cmd_prefix_len_(0),
       sink_(nullptr),
       sink_ctx_(nullptr),
-      q_head_(0),
-      q_tail_(0),
+      metrics_(nullptr),
+      heartbeat_interval_ms_(kDefaultHeartbeatIntervalMs),
+      sent_(0),
+      known_(0),
+      dirty_(0),
+      aggregate_(false),
+      next_topic_(0),
       last_reconnect_attempt_ms_(0),
-      last_publish_ms_(0),
+      stage_started_ms_(0),
+      attempt_started_ms_(0),
+      attempt_timed_out_(false),
+      publish_tokens_milli_(kDefaultPublishBurst * 1000UL),
+      last_refill_ms_(0),
+      publish_burst_(kDefaultPublishBurst),
+      publish_rate_per_s_(kDefaultPublishRatePerS),
+      publish_backoff_until_ms_(0),
+      publish_refusal_streak_(0),
       publish_drop_count_(0),
+      replay_seq_(0),
+      last_offline_capture_ms_(0),
+      uptime_ms_(0),
+      uptime_last_ms_(0),
+      rate_window_start_ms_(0),
+      rate_window_sent_(0),
       connect_fail_streak_(0),
       suspended_until_ms_(0),
       enabled_(false) {
     memset(&settings_, 0, sizeof(settings_));
     memset(root_, 0, sizeof(root_));
+    memset(values_, 0, sizeof(values_));
+    memset(sent_values_, 0, sizeof(sent_values_));
+    memset(sent_ms_, 0, sizeof(sent_ms_));
+    memset(dirty_since_ms_, 0, sizeof(dirty_since_ms_));
+    for (uint8_t i = 0; i < kTopicCount; ++i) {
+        deadband_abs_[i] = kTopicKeys[i].deadband_abs;
+        deadband_pct_[i] = kTopicKeys[i].deadband_pct;
+    }
+    memset(topic_pool_, 0, sizeof(topic_pool_));
+    memset(topic_offsets_, 0, sizeof(topic_offsets_));
+    memset(broker_ip_, 0, sizeof(broker_ip_));
     g_mqtt_router.handler = &MqttClient::onRouterMessage;
     g_mqtt_router.ctx = this;
 }
 
 MqttClient::~MqttClient() {
-    if (client_ != nullptr) {
-        delete client_;
-        client_ = nullptr;
-    }
+    connector_.waitIdle();
+    destroyClient();
     if (g_mqtt_router.ctx == this) {
         g_mqtt_router.handler = nullptr;
         g_mqtt_router.ctx = nullptr;
@@ -58,12 +256,23 @@ MqttClient::~MqttClient() {
 }
 
 void MqttClient::configure(const SettingsV2& settings) {
+    // The worker may be using client_ and the strings in settings_; a running
+    // stage cannot be cancelled, so this is the one place that waits for it.
+    connector_.waitIdle();
+    connector_.reset();
+    attempt_timed_out_ = false;
+
     settings_ = settings;
     connect_fail_streak_ = 0;
     suspended_until_ms_ = 0;
     last_reconnect_attempt_ms_ = 0;
-    q_head_ = 0;
-    q_tail_ = 0;
+    sent_ = 0;
+    known_ = 0;
+    dirty_ = 0;
+    next_topic_ = 0;
+    publish_tokens_milli_ = publish_burst_ * 1000UL;
+    publish_backoff_until_ms_ = 0;
+    publish_refusal_streak_ = 0;
 
     if (!isDeviceIdTopicSafe(settings_.device_id, sizeof(settings_.device_id) - 1)) {
         char normalized_id[sizeof(settings_.device_id)] = {0};
@@ -75,15 +284,17 @@ void MqttClient::configure(const SettingsV2& settings) {
     } else {
         buildDefaultTopicRoot(settings_.device_id, root_, sizeof(root_));
     }
+    buildTopicPool();
+    destroyClient();
 
-    if (client_ != nullptr) {
-        delete client_;
-        client_ = nullptr;
-    }
+    memset(broker_ip_, 0, sizeof(broker_ip_));
+
+    aggregate_ = (settings_.mqtt_publish_mode == static_cast<uint8_t>(MqttPublishMode::Aggregate));
 
+    // The client is created once the broker address has been resolved.
     enabled_ = (settings_.mqtt_enabled != 0) && (strlen(settings_.mqtt_host) > 0);
     if (enabled_) {
-        client_ = new MQTT(settings_.mqtt_host, settings_.mqtt_port, mqttCallbackBridge);
+        connector_.begin();
     }
 }
 
@@ -92,44 +303,19 @@ void MqttClient::setCommandSink(CommandSink sink, void* ctx) {
     sink_ctx_ = ctx;
 }
 
+void MqttClient::setMetrics(MetricsRegistry* metrics) {
+    metrics_ = metrics;
+}
+
 void MqttClient::tick(uint32_t now_ms, DeviceState& state) {
-    if (!enabled_ || client_ == nullptr || !state.wifi_ready) {
+    advanceUptime(now_ms);
+    if (!enabled_) {
         state.mqtt_connected = false;
         return;
     }
-
-    if (!client_->isConnected()) {
+    if (!state.wifi_ready || !advanceConnect(now_ms, state)) {
         state.mqtt_connected = false;
-
-        if (suspended_until_ms_ != 0 &&
-            static_cast<int32_t>(now_ms - suspended_until_ms_) < 0) {
-            return;
-        }
-
-        uint32_t retry_interval_ms = kReconnectBaseIntervalMs;
-        uint8_t backoff_shift = (connect_fail_streak_ > kReconnectBackoffMaxShift)
-                                    ? kReconnectBackoffMaxShift
-                                    : connect_fail_streak_;
-        retry_interval_ms <<= backoff_shift;
-
-        if (now_ms - last_reconnect_attempt_ms_ >= retry_interval_ms) {
-            last_reconnect_attempt_ms_ = now_ms;
-            bool ok = client_->connect(settings_.device_id, settings_.mqtt_user, settings_.mqtt_pass);
-            if (ok && client_->isConnected()) {
-                connect_fail_streak_ = 0;
-                suspended_until_ms_ = 0;
-                subscribeTopics();
-            } else {
-                if (connect_fail_streak_ < 255) {
-                    connect_fail_streak_ += 1;
-                }
-                if (connect_fail_streak_ >= kSuspendAfterFailStreak) {
-                    suspended_until_ms_ = now_ms + kSuspendDurationMs;
-                    connect_fail_streak_ = 0;
-                }
-            }
-            state.mqtt_reconnect_count += 1;
-        }
+        captureOffline(now_ms, state);
         return;
     }
 
@@ -137,44 +323,228 @@ void MqttClient::tick(uint32_t now_ms, DeviceState& state) {
     connect_fail_streak_ = 0;
     suspended_until_ms_ = 0;
     client_->loop();
+    drainPublishes(now_ms, state);
+}
 
-    if (now_ms - last_publish_ms_ < 25) {
+// Moves a connect attempt along by at most one stage per tick:
+// resolve host -> (re)create client -> connect/CONNACK -> subscribe.
+bool MqttClient::advanceConnect(uint32_t now_ms, DeviceState& state) {
+    if (connector_.busy()) {
+        uint32_t timeout_ms = (connector_.phase() == MqttConnector::Phase::Resolving)
+                                  ? kResolveTimeoutMs
+                                  : kConnectTimeoutMs;
+        if (!attempt_timed_out_ && now_ms - stage_started_ms_ >= timeout_ms) {
+            attempt_timed_out_ = true;
+            recordConnectFailure(now_ms);
+        }
+        return false;
+    }
+
+    switch (connector_.phase()) {
+        case MqttConnector::Phase::Resolved: {
+            uint8_t address[4];
+            connector_.resolvedAddress(address);
+            if (client_ == nullptr || memcmp(address, broker_ip_, sizeof(broker_ip_)) != 0) {
+                destroyClient();
+                memcpy(broker_ip_, address, sizeof(broker_ip_));
+                constructClient();
+            }
+            connector_.startConnect(client_, settings_.device_id, settings_.mqtt_user, settings_.mqtt_pass);
+            stage_started_ms_ = now_ms;
+            return false;
+        }
+        case MqttConnector::Phase::Connected:
+            // A late success after a timeout is still used.
+            connector_.reset();
+            connect_fail_streak_ = 0;
+            suspended_until_ms_ = 0;
+            subscribeTopics();
+            if (metrics_ != nullptr) {
+                metrics_->observe(HistogramId::MqttConnectMs, now_ms - attempt_started_ms_);
+            }
+            // Non-retained values: a new session starts from a full snapshot.
+            for (uint8_t i = 0; i < kTopicCount; ++i) {
+                if ((known_ & ~dirty_ & (1UL << i)) != 0) {
+                    dirty_since_ms_[i] = now_ms;
+                }
+            }
+            dirty_ |= known_;
+            return true;
+        case MqttConnector::Phase::Failed:
+            connector_.reset();
+            if (!attempt_timed_out_) {
+                recordConnectFailure(now_ms);
+            }
+            return false;
+        default:
+            break;
+    }
+
+    if (client_ != nullptr && client_->isConnected()) {
+        return true;
+    }
+
+    if (suspended_until_ms_ != 0 &&
+        static_cast<int32_t>(now_ms - suspended_until_ms_) < 0) {
+        return false;
+    }
+
+    uint32_t retry_interval_ms = kReconnectBaseIntervalMs;
+    uint8_t backoff_shift = (connect_fail_streak_ > kReconnectBackoffMaxShift)
+                                ? kReconnectBackoffMaxShift
+                                : connect_fail_streak_;
+    retry_interval_ms <<= backoff_shift;
+
+    if (now_ms - last_reconnect_attempt_ms_ >= retry_interval_ms) {
+        last_reconnect_attempt_ms_ = now_ms;
+        stage_started_ms_ = now_ms;
+        attempt_started_ms_ = now_ms;
+        attempt_timed_out_ = false;
+        connector_.startResolve(settings_.mqtt_host);
+        state.metrics.add(MetricId::MqttReconnects);
+    }
+    return false;
+}
+
+void MqttClient::constructClient() {
+    client_ = new (client_storage_) MQTT(broker_ip_, settings_.mqtt_port, kMaxPacketSize, mqttCallbackBridge);
+}
+
+// Only called while the connect worker is idle, so nothing else holds client_.
+void MqttClient::destroyClient() {
+    if (client_ == nullptr) {
         return;
     }
+    client_->~MQTT();
+    client_ = nullptr;
+}
 
-    PublishMessage msg;
-    if (queuePop(msg)) {
-        client_->publish(msg.topic, msg.payload);
-        last_publish_ms_ = now_ms;
+// Backoff is measured from the end of a failed attempt, so a slow attempt does
+// not eat into the retry interval.
+void MqttClient::recordConnectFailure(uint32_t now_ms) {
+    last_reconnect_attempt_ms_ = now_ms;
+    if (connect_fail_streak_ < 255) {
+        connect_fail_streak_ += 1;
+    }
+    if (connect_fail_streak_ >= kSuspendAfterFailStreak) {
+        suspended_until_ms_ = now_ms + kSuspendDurationMs;
+        connect_fail_streak_ = 0;
     }
 }
 
-void MqttClient::enqueueStatePublish(const char* key, int value) {
+void MqttClient::publishValue(MqttTopic topic, int32_t value, uint32_t now_ms) {
     if (!enabled_) {
         return;
     }
-    char topic[128];
-    char payload[24];
-    snprintf(topic, sizeof(topic), "%s/%s", root_, key);
-    snprintf(payload, sizeof(payload), "%d", value);
-    queuePush(topic, payload);
+    uint8_t index = static_cast<uint8_t>(topic);
+    uint32_t bit = 1UL << index;
+    values_[index] = value;
+    known_ |= bit;
+    if ((sent_ & bit) == 0 || exceedsDeadband(index, value) ||
+        (heartbeat_interval_ms_ != 0 && now_ms - sent_ms_[index] >= heartbeat_interval_ms_)) {
+        if ((dirty_ & bit) == 0) {
+            dirty_since_ms_[index] = now_ms;
+        }
+        dirty_ |= bit;
+    }
+}
+
+bool MqttClient::exceedsDeadband(uint8_t index, int32_t value) const {
+    int64_t delta = static_cast<int64_t>(value) - sent_values_[index];
+    if (delta < 0) {
+        delta = -delta;
+    }
+    int64_t last = sent_values_[index];
+    if (last < 0) {
+        last = -last;
+    }
+    int64_t band = last * deadband_pct_[index] / 100;
+    if (band < deadband_abs_[index]) {
+        band = deadband_abs_[index];
+    }
+    return delta > band;
+}
+
+void MqttClient::markSent(uint32_t bits, uint32_t now_ms) {
+    for (uint8_t i = 0; i < kTopicCount; ++i) {
+        if ((bits & (1UL << i)) == 0) {
+            continue;
+        }
+        // Latency covers only values that were waiting; group members sent
+        // alongside a dirty one were not.
+        if (metrics_ != nullptr && (dirty_ & (1UL << i)) != 0) {
+            metrics_->observe(HistogramId::MqttPublishLatencyMs, now_ms - dirty_since_ms_[i]);
+        }
+        sent_values_[i] = values_[i];
+        sent_ms_[i] = now_ms;
+    }
+    sent_ |= bits;
+    dirty_ &= ~bits;
+}
+
+void MqttClient::setDeadband(MqttTopic topic, uint16_t absolute, uint8_t relative_pct) {
+    uint8_t index = static_cast<uint8_t>(topic);
+    deadband_abs_[index] = absolute;
+    deadband_pct_[index] = relative_pct;
+}
+
+void MqttClient::setHeartbeatInterval(uint32_t interval_ms) {
+    heartbeat_interval_ms_ = interval_ms;
 }
 
 uint32_t MqttClient::publishDropCount() const {
     return publish_drop_count_;
 }
 
-void MqttClient::subscribeTopics() {
-    char topic[128];
+void MqttClient::setPublishPacing(uint8_t burst, uint16_t rate_per_s) {
+    publish_burst_ = (burst == 0) ? 1 : burst;
+    publish_rate_per_s_ = (rate_per_s == 0) ? 1 : rate_per_s;
+    uint32_t capacity = publish_burst_ * 1000UL;
+    if (publish_tokens_milli_ > capacity) {
+        publish_tokens_milli_ = capacity;
+    }
+}
 
-    snprintf(topic, sizeof(topic), "%s/cmd/fan_percent", root_);
-    client_->subscribe(topic);
+void MqttClient::buildTopicPool() {
+    static_assert(kGroupNameCount == kGroupCount, "group table out of sync");
+    static_assert(kTopicPoolSize >= kPooledTopicCount * (sizeof(SettingsV2::mqtt_topic_root) + 1) + kTopicSuffixBytes,
+                  "topic pool too small for the longest root");
+
+    size_t root_len = strlen(root_);
+    size_t used = 0;
+    for (uint8_t i = 0; i < kPooledTopicCount; ++i) {
+        const char* group = kCommandGroup;
+        const char* key = "";
+        if (i < kGroupTopicBase) {
+            group = kGroupNames[kTopicKeys[i].group];
+            key = kTopicKeys[i].name;
+        } else if (i < kCommandTopic) {
+            group = kGroupNames[i - kGroupTopicBase];
+        } else if (i == kHistoryTopic) {
+            group = kHistoryGroup;
+        } else {
+            key = "#";
+        }
+        int written = snprintf(topic_pool_ + used, sizeof(topic_pool_) - used, "%s/%s%s%s", root_, group,
+                               (key[0] != '\0') ? "/" : "", key);
+        topic_offsets_[i] = static_cast<uint16_t>(used);
+        if (written < 0 || used + static_cast<size_t>(written) + 1 > sizeof(topic_pool_)) {
+            // Unreachable for a validated root; keeps offsets in bounds regardless.
+            topic_offsets_[i] = static_cast<uint16_t>(sizeof(topic_pool_) - 1);
+            continue;
+        }
+        used += static_cast<size_t>(written) + 1;
+    }
+    cmd_prefix_len_ = root_len + strlen("/cmd/");
+}
 
-    snprintf(topic, sizeof(topic), "%s/cmd/lights", root_);
-    client_->subscribe(topic);
+const char* MqttClient::pooledTopic(uint8_t index) const {
+    return topic_pool_ + topic_offsets_[index];
+}
 
-    snprintf(topic, sizeof(topic), "%s/cmd/screen_light", root_);
-    client_->subscribe(topic);
+void MqttClient::subscribeTopics() {
+    // One wildcard covers every command; new commands only extend the table.
+    client_->subscribe(pooledTopic(kCommandTopic));
 }
 
 void MqttClient::onMessage(char* topic, uint8_t* payload, unsigned int length) {
@@ -192,76 +562,250 @@ void MqttClient::onMessage(char* topic, uint8_t* payload, unsigned int length) {
 
     Command cmd;
     if (!parseCommand(topic, payload_buf, cmd)) {
+        if (metrics_ != nullptr) {
+            metrics_->add(MetricId::MqttCommandsRejected);
+        }
         return;
     }
+    if (metrics_ != nullptr) {
+        metrics_->add(MetricId::MqttCommandsReceived);
+    }
     sink_(cmd, sink_ctx_);
 }
 
+// One prefix compare against the interned "<root>/cmd/", then a hashed lookup
+// of the remaining suffix; nothing is formatted per message.
 bool MqttClient::parseCommand(const char* topic, const char* payload, Command& out) const {
-    char fan_topic[128];
-    char lights_topic[128];
-    char screen_light_topic[128];
-    snprintf(fan_topic, sizeof(fan_topic), "%s/cmd/fan_percent", root_);
-    snprintf(lights_topic, sizeof(lights_topic), "%s/cmd/lights", root_);
-    snprintf(screen_light_topic, sizeof(screen_light_topic), "%s/cmd/screen_light", root_);
+    if (strncmp(topic, pooledTopic(kCommandTopic), cmd_prefix_len_) != 0) {
+        return false;
+    }
+    const char* suffix = topic + cmd_prefix_len_;
 
+    const CommandTopic* entry = findCommandTopic(suffix, strlen(suffix));
+    if (entry == nullptr) {
+        return false;
+    }
+    int value = 0;
+    if (!entry->parse(payload, entry->min_value, entry->max_value, value)) {
+        return false;
+    }
     out.source = CommandSource::Mqtt;
-    out.value = 0;
+    out.type = entry->type;
+    out.value = value;
+    return true;
+}
 
-    if (strcmp(topic, fan_topic) == 0) {
-        int fan_percent = 0;
-        if (!parseIntStrict(payload, 0, 100, fan_percent)) {
-            return false;
-        }
-        out.type = CommandType::SetFanPercent;
-        out.value = fan_percent;
-        return true;
+// Refills the bucket, then sends as many dirty topics as there are whole tokens.
+// The MQTT client writes each publish straight to the socket, so a refusal is the
+// only sign the connection is backed up: stop for this tick and back off.
+void MqttClient::drainPublishes(uint32_t now_ms, DeviceState& state) {
+    uint32_t capacity = publish_burst_ * 1000UL;
+    uint32_t elapsed = now_ms - last_refill_ms_;
+    last_refill_ms_ = now_ms;
+    if (elapsed > kPublishRateWindowMs) {
+        elapsed = kPublishRateWindowMs;  // a full bucket is reached well before this
     }
-    if (strcmp(topic, lights_topic) == 0) {
-        int lights = 0;
-        if (!parseIntStrict(payload, 0, 1, lights)) {
-            return false;
-        }
-        out.type = CommandType::SetLights;
-        out.value = lights;
-        return true;
+    publish_tokens_milli_ += elapsed * publish_rate_per_s_;
+    if (publish_tokens_milli_ > capacity) {
+        publish_tokens_milli_ = capacity;
     }
-    if (strcmp(topic, screen_light_topic) == 0) {
-        int screen_light = 0;
-        if (!parseIntStrict(payload, 0, 1, screen_light)) {
-            return false;
+
+    if (now_ms - rate_window_start_ms_ >= kPublishRateWindowMs) {
+        uint32_t window_ms = now_ms - rate_window_start_ms_;
+        state.metrics.set(MetricId::MqttPublishRate, rate_window_sent_ * 1000UL / window_ms);
+        rate_window_start_ms_ = now_ms;
+        rate_window_sent_ = 0;
+    }
+
+    if (publish_refusal_streak_ > 0 &&
+        static_cast<int32_t>(now_ms - publish_backoff_until_ms_) < 0) {
+        return;
+    }
+
+    while (publish_tokens_milli_ >= 1000) {
+        // Live values go first; the offline backlog uses the tokens left over.
+        PublishResult result = publishNextDirty(now_ms);
+        if (result == PublishResult::Idle) {
+            result = publishHistoryBatch(now_ms);
         }
-        out.type = CommandType::SetScreenLight;
-        out.value = screen_light;
-        return true;
+        if (result == PublishResult::Idle) {
+            break;
+        }
+        publish_tokens_milli_ -= 1000;
+        if (result == PublishResult::Refused) {
+            uint8_t shift = (publish_refusal_streak_ > kPublishBackoffMaxShift)
+                                ? kPublishBackoffMaxShift
+                                : publish_refusal_streak_;
+            publish_backoff_until_ms_ = now_ms + (kPublishBackoffBaseMs << shift);
+            if (publish_refusal_streak_ < 255) {
+                publish_refusal_streak_ += 1;
+            }
+            return;
+        }
+        publish_refusal_streak_ = 0;
+        rate_window_sent_ += 1;
+        state.metrics.add(MetricId::MqttPublishes);
     }
+    state.metrics.set(MetricId::MqttOfflineBacklog, offline_.total() - replay_seq_);
+}
 
-    return false;
+void MqttClient::advanceUptime(uint32_t now_ms) {
+    uptime_ms_ += now_ms - uptime_last_ms_;
+    uptime_last_ms_ = now_ms;
+}
+
+// Drop-oldest: the ring overwrites its oldest sample, and a sample that was
+// overwritten before replay reached it is counted as lost.
+void MqttClient::captureOffline(uint32_t now_ms, DeviceState& state) {
+    if (now_ms - last_offline_capture_ms_ < kOfflineCaptureIntervalMs) {
+        return;
+    }
+    last_offline_capture_ms_ = now_ms;
+
+    if (offline_.total() - replay_seq_ >= kOfflineCapacity) {
+        replay_seq_ += 1;
+        state.metrics.add(MetricId::MqttOfflineDrops);
+    }
+    OfflineSample sample;
+    sample.uptime_s = static_cast<uint32_t>(uptime_ms_ / 1000);
+    sample.pm25 = static_cast<uint16_t>(state.pm25_smooth);
+    sample.pm10 = static_cast<uint16_t>(state.pm10_smooth);
+    sample.fan_percent = static_cast<uint8_t>(state.fan_percent);
+    sample.lights_on = state.lights_on ? 1 : 0;
+    offline_.push(sample);
+    state.metrics.set(MetricId::MqttOfflineBacklog, offline_.total() - replay_seq_);
 }
 
-bool MqttClient::queuePush(const char* topic, const char* payload) {
-    uint8_t next = static_cast<uint8_t>((q_tail_ + 1) % kQueueSize);
-    if (next == q_head_) {
+// {"clock":"unix","samples":[[ts,pm25,pm10,fan_percent,lights],...]}, oldest
+// first. ts is Unix seconds when the device clock is valid at replay time,
+// otherwise seconds since boot with "clock":"uptime".
+MqttClient::PublishResult MqttClient::publishHistoryBatch(uint32_t now_ms) {
+    uint32_t end = offline_.total();
+    if (replay_seq_ == end) {
+        return PublishResult::Idle;
+    }
+
+    bool unix_clock = Time.isValid();
+    uint32_t now_uptime_s = static_cast<uint32_t>(uptime_ms_ / 1000);
+    uint32_t now_unix = unix_clock ? Time.now() : 0;
+
+    char payload[kHistoryPayloadSize];
+    BufferSink sink(payload, sizeof(payload));
+    char number[12];
+    const char* head = unix_clock ? "{\"clock\":\"unix\",\"samples\":[" : "{\"clock\":\"uptime\",\"samples\":[";
+    sink.write(head, strlen(head));
+
+    uint32_t seq = replay_seq_;
+    for (size_t n = 0; n < kHistoryBatchSamples && seq != end; ++n, ++seq) {
+        const OfflineSample& sample = offline_.at(seq);
+        uint32_t ts = sample.uptime_s;
+        if (unix_clock) {
+            uint32_t age_s = (now_uptime_s >= sample.uptime_s) ? now_uptime_s - sample.uptime_s : 0;
+            ts = now_unix - age_s;
+        }
+        const int32_t row[] = {static_cast<int32_t>(ts), sample.pm25, sample.pm10, sample.fan_percent,
+                               sample.lights_on};
+        sink.write((n == 0) ? "[" : ",[", (n == 0) ? 1 : 2);
+        for (size_t i = 0; i < sizeof(row) / sizeof(row[0]); ++i) {
+            if (i > 0) {
+                sink.write(",", 1);
+            }
+            formatInt32(row[i], number);
+            sink.write(number, strlen(number));
+        }
+        sink.write("]", 1);
+    }
+    sink.write("]}", 2);
+
+    if (sink.overflowed()) {
+        // Unreachable with kHistoryPayloadSize; skip the batch rather than stall.
+        replay_seq_ = seq;
         publish_drop_count_ += 1;
-        return false;
+        return PublishResult::Refused;
+    }
+    if (!timedPublish(pooledTopic(kHistoryTopic), reinterpret_cast<const uint8_t*>(payload), sink.length())) {
+        publish_drop_count_ += 1;
+        return PublishResult::Refused;
     }
+    replay_seq_ = seq;
+    return PublishResult::Sent;
+}
 
-    strncpy(queue_[q_tail_].topic, topic, sizeof(queue_[q_tail_].topic) - 1);
-    queue_[q_tail_].topic[sizeof(queue_[q_tail_].topic) - 1] = '\0';
-    strncpy(queue_[q_tail_].payload, payload, sizeof(queue_[q_tail_].payload) - 1);
-    queue_[q_tail_].payload[sizeof(queue_[q_tail_].payload) - 1] = '\0';
-    q_tail_ = next;
-    return true;
+// publish() writes to the socket synchronously, so its duration shows how much
+// a slow broker or full TCP window costs the loop.
+bool MqttClient::timedPublish(const char* topic, const uint8_t* payload, size_t length) {
+    uint32_t start_us = micros();
+    bool ok = client_->publish(topic, payload, static_cast<unsigned int>(length));
+    if (metrics_ != nullptr) {
+        metrics_->observe(HistogramId::MqttPublishCallUs, micros() - start_us);
+    }
+    return ok;
 }
 
-bool MqttClient::queuePop(PublishMessage& out) {
-    if (q_head_ == q_tail_) {
-        return false;
+// Sends the first dirty topic at or after next_topic_, wrapping around, so a
+// frequently updated topic cannot starve the others.
+MqttClient::PublishResult MqttClient::publishNextDirty(uint32_t now_ms) {
+    static_assert(kTopicCount <= 32, "dirty bitmap holds 32 topics");
+    if (dirty_ == 0) {
+        return PublishResult::Idle;
     }
 
-    out = queue_[q_head_];
-    q_head_ = static_cast<uint8_t>((q_head_ + 1) % kQueueSize);
-    return true;
+    for (uint8_t step = 0; step < kTopicCount; ++step) {
+        uint8_t index = static_cast<uint8_t>((next_topic_ + step) % kTopicCount);
+        uint32_t bit = 1UL << index;
+        if ((dirty_ & bit) == 0) {
+            continue;
+        }
+
+        next_topic_ = static_cast<uint8_t>((index + 1) % kTopicCount);
+        if (aggregate_) {
+            return publishGroup(kTopicKeys[index].group, now_ms);
+        }
+        char payload[12];
+        formatInt32(values_[index], payload);
+        if (!timedPublish(pooledTopic(index), reinterpret_cast<const uint8_t*>(payload), strlen(payload))) {
+            publish_drop_count_ += 1;
+            return PublishResult::Refused;
+        }
+        markSent(bit, now_ms);
+        return PublishResult::Sent;
+    }
+    return PublishResult::Idle;
+}
+
+// One document with every known value of the group, e.g.
+// {"fan_percent":40,"fan_pwm":102,"lights":1}; clears the whole group on success.
+MqttClient::PublishResult MqttClient::publishGroup(uint8_t group, uint32_t now_ms) {
+    char payload[kAggregatePayloadSize];
+    BufferSink sink(payload, sizeof(payload));
+    JsonWriter<BufferSink> json(sink);
+    uint32_t group_bits = 0;
+
+    json.beginObject();
+    for (uint8_t i = 0; i < kTopicCount; ++i) {
+        if (kTopicKeys[i].group != group) {
+            continue;
+        }
+        group_bits |= (1UL << i);
+        if ((known_ & (1UL << i)) != 0) {
+            json.member(kTopicKeys[i].name, jsonInt(values_[i]));
+        }
+    }
+    json.endObject();
+
+    if (sink.overflowed()) {
+        // Unreachable with kAggregatePayloadSize; drop rather than retry forever.
+        dirty_ &= ~group_bits;
+        publish_drop_count_ += 1;
+        return PublishResult::Refused;
+    }
+    if (!timedPublish(pooledTopic(kGroupTopicBase + group), reinterpret_cast<const uint8_t*>(payload),
+                      sink.length())) {
+        publish_drop_count_ += 1;
+        return PublishResult::Refused;
+    }
+    markSent(group_bits & known_, now_ms);
+    return PublishResult::Sent;
 }
 
 void MqttClient::onRouterMessage(void* ctx, char* topic, uint8_t* payload, unsigned int length) {
@@ -6,6 +6,26 @@
 #include "../app/command.h"
 #include "../core/device_state.h"
 #include "../core/settings_store.h"
+#include "mqtt_connector.h"
+
+// Every value the firmware publishes, each on its own non-retained topic. Topic
+// suffixes (below the configured root) are listed in mqtt_client.cpp in this order.
+enum class MqttTopic : uint8_t {
+    StateFanPercent = 0,
+    StateFanPwm,
+    StateLights,
+    SensorPm25,
+    SensorPm10,
+    HealthUptime,
+    HealthWifiReconnects,
+    HealthMqttReconnects,
+    HealthSensorParseErrors,
+    HealthCommandDropsButton,
+    HealthCommandDropsMqtt,
+    HealthCommandDropsWeb,
+    HealthMqttPublishDrops,
+    Count,
+};
 
 class MqttClient {
 public:
@@ -16,42 +36,147 @@ public:
 
     void configure(const SettingsV2& settings);
     void setCommandSink(CommandSink sink, void* ctx);
+    // Registry for the MQTT latency histograms and command counters, which are
+    // recorded outside tick(). Optional.
+    void setMetrics(MetricsRegistry* metrics);
     void tick(uint32_t now_ms, DeviceState& state);
 
-    void enqueueStatePublish(const char* key, int value);
+    // Records the latest value for `topic`; it is sent on a later tick if it
+    // moved beyond the topic's deadband since it was last sent, or the heartbeat
+    // interval has passed. A value overwritten before it goes out is never sent.
+    void publishValue(MqttTopic topic, int32_t value, uint32_t now_ms);
+    // publish() calls the client refused; the value stays pending and is retried.
     uint32_t publishDropCount() const;
+    // Token-bucket pacing: up to `burst` publishes back to back, refilled at
+    // `rate_per_s`. Both are clamped to at least 1.
+    void setPublishPacing(uint8_t burst, uint16_t rate_per_s);
+    // A change is published once |new - last sent| exceeds the larger of
+    // `absolute` and `relative_pct` percent of the last sent value. Defaults
+    // are per topic (mqtt_client.cpp); 0/0 publishes every change.
+    void setDeadband(MqttTopic topic, uint16_t absolute, uint8_t relative_pct);
+    // Unchanged values are re-sent at least this often; 0 disables.
+    void setHeartbeatInterval(uint32_t interval_ms);
 
 private:
-    struct PublishMessage {
-        char topic[128];
-        char payload[24];
+    // One sample captured while the broker is unreachable; 12 bytes.
+    struct OfflineSample {
+        uint32_t uptime_s;  // from uptime_ms_, so it survives the millis() wrap
+        uint16_t pm25;
+        uint16_t pm10;
+        uint8_t fan_percent;
+        uint8_t lights_on;
+    };
+    // 160 samples at 30 s cover 80 minutes in under 2 KB; older samples are
+    // overwritten first.
+    static const size_t kOfflineCapacity = 160;
+
+    enum class PublishResult : uint8_t {
+        Idle,
+        Sent,
+        Refused,
     };
 
-    static const uint8_t kQueueSize = 10;
+    static const uint8_t kTopicCount = static_cast<uint8_t>(MqttTopic::Count);
+    // state, sensor, health: one aggregate document each.
+    static const uint8_t kGroupCount = 3;
+    // Pool order: per-value topics, group topics, the "<root>/cmd/#"
+    // subscription, history.
+    static const uint8_t kGroupTopicBase = kTopicCount;
+    static const uint8_t kCommandTopic = kGroupTopicBase + kGroupCount;
+    static const uint8_t kHistoryTopic = kCommandTopic + 1;
+    static const uint8_t kPooledTopicCount = kHistoryTopic + 1;
+    // Worst case: every topic under the longest storable root, each with its
+    // "/" and terminator, plus the suffixes after the root (309 bytes today).
+    // buildTopicPool() checks the suffix budget against the tables.
+    static const size_t kTopicPoolSize = kPooledTopicCount * (sizeof(SettingsV2::mqtt_topic_root) + 1) + 320;
 
+    // The library client is placement-constructed in client_storage_ for each
+    // broker address and destroyed in place, so reconfiguring never returns the
+    // object to the heap. client_ is null or points into the storage.
+    alignas(MQTT) uint8_t client_storage_[sizeof(MQTT)];
     MQTT* client_;
     SettingsV2 settings_;
     char root_[96];
+    // Full topic strings, built once in configure() and addressed by offset.
+    char topic_pool_[kTopicPoolSize];
+    uint16_t topic_offsets_[kPooledTopicCount];
+    // Length of "<root>/cmd/", shared by every command topic.
+    size_t cmd_prefix_len_;
 
     CommandSink sink_;
     void* sink_ctx_;
+    MetricsRegistry* metrics_;
 
-    PublishMessage queue_[kQueueSize];
-    uint8_t q_head_;
-    uint8_t q_tail_;
+    // Last value per topic plus a dirty bit, drained round-robin from next_topic_.
+    int32_t values_[kTopicCount];
+    // What the broker last received per topic, for the deadband and heartbeat.
+    int32_t sent_values_[kTopicCount];
+    uint32_t sent_ms_[kTopicCount];
+    // When each pending topic last went from clean to dirty, for publish latency.
+    uint32_t dirty_since_ms_[kTopicCount];
+    uint16_t deadband_abs_[kTopicCount];
+    uint8_t deadband_pct_[kTopicCount];
+    uint32_t heartbeat_interval_ms_;
+    uint32_t sent_;  // topics in sent_values_
+    // Topics written at least once; aggregate documents leave the rest out.
+    uint32_t known_;
+    uint32_t dirty_;
+    bool aggregate_;
+    uint8_t next_topic_;
     uint32_t last_reconnect_attempt_ms_;
-    uint32_t last_publish_ms_;
+    // Connect attempts run in stages on connector_; the loop only polls them.
+    MqttConnector connector_;
+    uint8_t broker_ip_[4];
+    uint32_t stage_started_ms_;
+    uint32_t attempt_started_ms_;
+    bool attempt_timed_out_;
+    // Tokens are kept in thousandths so a rate in messages/s refills by
+    // rate * elapsed_ms without division.
+    uint32_t publish_tokens_milli_;
+    uint32_t last_refill_ms_;
+    uint8_t publish_burst_;
+    uint16_t publish_rate_per_s_;
+    // After a refused publish nothing is sent until this time; the delay
+    // doubles per consecutive refusal.
+    uint32_t publish_backoff_until_ms_;
+    uint8_t publish_refusal_streak_;
     uint32_t publish_drop_count_;
+    // Samples captured while disconnected, replayed oldest first after a
+    // reconnect; replay_seq_ is the next ring sequence to send.
+    SampleRing<OfflineSample, kOfflineCapacity> offline_;
+    uint32_t replay_seq_;
+    uint32_t last_offline_capture_ms_;
+    // Uptime extended past the 49.7-day millis() wrap by adding the (wrap-safe)
+    // difference on every tick; sample and replay timestamps come from it.
+    uint64_t uptime_ms_;
+    uint32_t uptime_last_ms_;
+    // Achieved throughput, measured over fixed windows.
+    uint32_t rate_window_start_ms_;
+    uint32_t rate_window_sent_;
     uint8_t connect_fail_streak_;
     uint32_t suspended_until_ms_;
     bool enabled_;
 
+    // Returns true once the client is connected and usable this tick.
+    bool advanceConnect(uint32_t now_ms, DeviceState& state);
+    void recordConnectFailure(uint32_t now_ms);
+    void constructClient();
+    void destroyClient();
+    void buildTopicPool();
+    const char* pooledTopic(uint8_t index) const;
     void subscribeTopics();
     void onMessage(char* topic, uint8_t* payload, unsigned int length);
     bool parseCommand(const char* topic, const char* payload, Command& out) const;
 
-    bool queuePush(const char* topic, const char* payload);
-    bool queuePop(PublishMessage& out);
+    PublishResult publishNextDirty(uint32_t now_ms);
+    bool timedPublish(const char* topic, const uint8_t* payload, size_t length);
+    PublishResult publishGroup(uint8_t group, uint32_t now_ms);
+    void advanceUptime(uint32_t now_ms);
+    void captureOffline(uint32_t now_ms, DeviceState& state);
+    PublishResult publishHistoryBatch(uint32_t now_ms);
+    bool exceedsDeadband(uint8_t index, int32_t value) const;
+    void markSent(uint32_t bits, uint32_t now_ms);
+    void drainPublishes(uint32_t now_ms, DeviceState& state);
 
     static void onRouterMessage(void* ctx, char* topic, uint8_t* payload, unsigned int length);
 };
@@ -0,0 +1,104 @@
+#include "mqtt_connector.h"
+
+#include <new>
+#include <string.h>
+
+namespace {
+// Worker poll period while idle; a stage starts within this after start*().
+const uint32_t kWorkerPollMs = 20;
+const size_t kWorkerStackSize = 3072;
+}  // namespace
+
+MqttConnector::MqttConnector()
+    : phase_(static_cast<uint8_t>(Phase::Idle)),
+      thread_(nullptr),
+      host_(nullptr),
+      client_(nullptr),
+      id_(nullptr),
+      user_(nullptr),
+      pass_(nullptr) {
+    memset(address_, 0, sizeof(address_));
+}
+
+void MqttConnector::begin() {
+    if (thread_ != nullptr) {
+        return;
+    }
+    thread_ = new (thread_storage_) Thread("mqtt_connect", workerMain, this, OS_THREAD_PRIORITY_DEFAULT, kWorkerStackSize);
+}
+
+MqttConnector::Phase MqttConnector::phase() const {
+    return static_cast<Phase>(phase_.load());
+}
+
+bool MqttConnector::busy() const {
+    Phase p = phase();
+    return p == Phase::Resolving || p == Phase::Connecting;
+}
+
+void MqttConnector::startResolve(const char* host) {
+    if (busy()) {
+        return;
+    }
+    host_ = host;
+    // Publishing the phase hands host_ to the worker.
+    phase_.store(static_cast<uint8_t>(Phase::Resolving));
+}
+
+void MqttConnector::resolvedAddress(uint8_t out[4]) const {
+    memcpy(out, address_, sizeof(address_));
+}
+
+void MqttConnector::startConnect(MQTT* client, const char* id, const char* user, const char* pass) {
+    if (busy() || client == nullptr) {
+        return;
+    }
+    client_ = client;
+    id_ = id;
+    user_ = user;
+    pass_ = pass;
+    phase_.store(static_cast<uint8_t>(Phase::Connecting));
+}
+
+void MqttConnector::reset() {
+    if (busy()) {
+        return;
+    }
+    phase_.store(static_cast<uint8_t>(Phase::Idle));
+}
+
+void MqttConnector::waitIdle() const {
+    while (busy()) {
+        delay(kWorkerPollMs);
+    }
+}
+
+os_thread_return_t MqttConnector::workerMain(void* arg) {
+    MqttConnector* self = static_cast<MqttConnector*>(arg);
+    while (true) {
+        Phase p = self->phase();
+        if (p == Phase::Resolving || p == Phase::Connecting) {
+            self->runStage(p);
+        } else {
+            delay(kWorkerPollMs);
+        }
+    }
+}
+
+void MqttConnector::runStage(Phase phase) {
+    if (phase == Phase::Resolving) {
+        IPAddress ip = WiFi.resolve(host_);
+        if (!ip) {
+            phase_.store(static_cast<uint8_t>(Phase::Failed));
+            return;
+        }
+        for (uint8_t i = 0; i < 4; ++i) {
+            address_[i] = ip[i];
+        }
+        phase_.store(static_cast<uint8_t>(Phase::Resolved));
+        return;
+    }
+
+    bool ok = client_->connect(id_, user_, pass_) && client_->isConnected();
+    phase_.store(static_cast<uint8_t>(ok ? Phase::Connected : Phase::Failed));
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "Particle.h"
+#include <MQTT.h>
+
+#include <atomic>
+
+// Runs the blocking parts of an MQTT connect (DNS lookup, then the library's
+// TCP connect + CONNECT + CONNACK wait) on a worker thread, one stage per
+// request, so the firmware loop only polls phase() between ticks.
+//
+// Ownership follows the phase: while busy() the worker owns the MQTT object
+// and the strings passed to start*(); otherwise the caller does. A stage that
+// is already running cannot be cancelled, so callers enforce their own
+// deadlines and must wait for !busy() before freeing anything the worker uses.
+class MqttConnector {
+public:
+    enum class Phase : uint8_t {
+        Idle = 0,
+        Resolving,
+        Resolved,
+        Connecting,
+        Connected,
+        Failed,
+    };
+
+    MqttConnector();
+
+    // Starts the worker thread on first use.
+    void begin();
+
+    Phase phase() const;
+    bool busy() const;
+
+    // Idle -> Resolving -> Resolved | Failed.
+    void startResolve(const char* host);
+    // Valid in Resolved.
+    void resolvedAddress(uint8_t out[4]) const;
+    // Idle/Resolved -> Connecting -> Connected | Failed.
+    void startConnect(MQTT* client, const char* id, const char* user, const char* pass);
+    // Drops a finished result and returns to Idle; no-op while busy.
+    void reset();
+    // Blocks until the running stage (if any) finishes. Only for reconfiguration.
+    void waitIdle() const;
+
+private:
+    static os_thread_return_t workerMain(void* arg);
+    void runStage(Phase phase);
+
+    std::atomic<uint8_t> phase_;
+    // Created once in begin(); placement storage keeps it off the heap.
+    alignas(Thread) uint8_t thread_storage_[sizeof(Thread)];
+    Thread* thread_;
+
+    const char* host_;
+    MQTT* client_;
+    const char* id_;
+    const char* user_;
+    const char* pass_;
+    uint8_t address_[4];
+};
@@ -0,0 +1,95 @@
+#include "response_writer.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+ResponseWriter::ResponseWriter()
+    : client_(nullptr), len_(0), bytes_(0), segments_(0), failed_(false) {}
+
+void ResponseWriter::begin(TCPClient& client) {
+    client_ = &client;
+    len_ = 0;
+    bytes_ = 0;
+    segments_ = 0;
+    failed_ = false;
+}
+
+void ResponseWriter::write(const char* data, size_t len) {
+    while (len > 0) {
+        // Whole segments of a large body go out straight from the source.
+        if (len_ == 0 && len >= kSegmentSize) {
+            if (client_->write(reinterpret_cast<const uint8_t*>(data), kSegmentSize) != kSegmentSize) {
+                failed_ = true;
+            }
+            bytes_ += kSegmentSize;
+            ++segments_;
+            data += kSegmentSize;
+            len -= kSegmentSize;
+            continue;
+        }
+
+        size_t room = kSegmentSize - len_;
+        size_t chunk = (len < room) ? len : room;
+        memcpy(buf_ + len_, data, chunk);
+        len_ += chunk;
+        data += chunk;
+        len -= chunk;
+        if (len_ == kSegmentSize) {
+            flush();
+        }
+    }
+}
+
+void ResponseWriter::print(const char* text) {
+    write(text, strlen(text));
+}
+
+void ResponseWriter::printf(const char* format, ...) {
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        size_t room = kSegmentSize - len_;
+        va_list args;
+        va_start(args, format);
+        int written = vsnprintf(buf_ + len_, room, format, args);
+        va_end(args);
+        if (written < 0) {
+            return;
+        }
+        if (static_cast<size_t>(written) < room) {
+            len_ += static_cast<size_t>(written);
+            return;
+        }
+        if (len_ == 0) {
+            // Longer than a whole segment: keep what fit.
+            len_ = kSegmentSize - 1;
+            return;
+        }
+        flush();
+    }
+}
+
+bool ResponseWriter::end() {
+    flush();
+    client_ = nullptr;
+    return !failed_;
+}
+
+uint32_t ResponseWriter::bytes() const {
+    return bytes_;
+}
+
+uint16_t ResponseWriter::segments() const {
+    return segments_;
+}
+
+void ResponseWriter::flush() {
+    if (len_ == 0 || client_ == nullptr) {
+        return;
+    }
+    if (client_->write(reinterpret_cast<const uint8_t*>(buf_), len_) != len_) {
+        failed_ = true;
+    }
+    bytes_ += len_;
+    ++segments_;
+    len_ = 0;
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Particle.h"
+
+// Assembles an HTTP response (status line, headers and body) in one fixed buffer
+// and hands it to the socket a full segment at a time, so a small response
+// leaves in a single TCP segment instead of one per header line.
+class ResponseWriter {
+public:
+    // 1500-byte Wi-Fi MTU minus IPv4 and TCP headers.
+    static const size_t kSegmentSize = 1460;
+
+    ResponseWriter();
+
+    void begin(TCPClient& client);
+    void write(const char* data, size_t len);
+    void print(const char* text);
+    void printf(const char* format, ...);
+    // Flushes what is left; false if the socket refused any part of the response.
+    bool end();
+
+    uint32_t bytes() const;
+    uint16_t segments() const;
+
+private:
+    void flush();
+
+    TCPClient* client_;
+    char buf_[kSegmentSize];
+    size_t len_;
+    uint32_t bytes_;
+    uint16_t segments_;
+    bool failed_;
+};
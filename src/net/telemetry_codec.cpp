@@ -0,0 +1,78 @@
+#include "telemetry_codec.h"
+
+#include "../util/le_codec.h"
+
+namespace {
+void writeHeader(LeWriter& w, const char* magic, uint16_t version) {
+    for (int i = 0; i < 4; ++i) {
+        w.u8(static_cast<uint8_t>(magic[i]));
+    }
+    w.u16(version);
+    w.u16(0);  // payload length, patched once known
+}
+
+size_t finishRecord(LeWriter& w) {
+    if (w.overflow()) {
+        return 0;
+    }
+    w.patchU16(6, static_cast<uint16_t>(w.length() - kTelemetryHeaderSize));
+    return w.length();
+}
+
+uint16_t clampU16(int value) {
+    if (value < 0) {
+        return 0;
+    }
+    if (value > 0xFFFF) {
+        return 0xFFFF;
+    }
+    return static_cast<uint16_t>(value);
+}
+}  // namespace
+
+size_t encodeStateBin(const DeviceState& state, bool mqtt_enabled, uint32_t now_ms, uint8_t* out, size_t size) {
+    LeWriter w(out, size);
+    writeHeader(w, "AEST", kStateBinSchemaVersion);
+
+    uint8_t flags = 0;
+    flags |= state.lights_on ? 0x01 : 0;
+    flags |= state.screen_light_on ? 0x02 : 0;
+    flags |= state.wifi_ready ? 0x04 : 0;
+    flags |= state.mqtt_connected ? 0x08 : 0;
+    flags |= mqtt_enabled ? 0x10 : 0;
+
+    w.u32((now_ms - state.boot_ms) / 1000);
+    w.u32(now_ms - state.last_sensor_packet_ms);
+    w.u16(clampU16(state.pm25_smooth));
+    w.u16(clampU16(state.pm10_smooth));
+    w.u8(static_cast<uint8_t>(clampU16(state.fan_percent)));
+    w.u8(flags);
+    w.u16(0);
+    const MetricsRegistry& m = state.metrics;
+    w.u32(m.get(MetricId::WifiReconnects));
+    w.u32(m.get(MetricId::MqttReconnects));
+    w.u32(m.get(MetricId::SensorParseErrors));
+    w.u32(m.get(MetricId::CommandDropsButton));
+    w.u32(m.get(MetricId::CommandDropsMqtt));
+    w.u32(m.get(MetricId::CommandDropsWeb));
+    w.u32(m.get(MetricId::MqttPublishDrops));
+    w.u32(m.get(MetricId::DisplayUpdates));
+    w.u32(m.get(MetricId::DisplayBytes));
+    w.u32(m.get(MetricId::HttpResponses));
+    return finishRecord(w);
+}
+
+size_t encodeHistoryBin(const DeviceState& state, uint8_t* out, size_t size) {
+    LeWriter w(out, size);
+    writeHeader(w, "AEHI", kHistoryBinSchemaVersion);
+
+    const uint32_t next_seq = state.pm25_history.total();
+    const size_t count = state.pm25_history.size();
+    w.u16(static_cast<uint16_t>(kPmHistoryIntervalMs / 1000));
+    w.u16(static_cast<uint16_t>(count));
+    w.u32(next_seq);
+    for (uint32_t seq = next_seq - static_cast<uint32_t>(count); seq != next_seq; ++seq) {
+        w.u16(state.pm25_history.at(seq));
+    }
+    return finishRecord(w);
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Particle.h"
+
+#include "../core/device_state.h"
+
+// Fixed-layout little-endian telemetry records served as state.bin and
+// history.bin. Every record starts with an 8-byte header:
+//   char[4] magic ("AEST" / "AEHI"), u16 schema version, u16 payload length.
+// Fields are only ever appended within a schema version; a layout change bumps
+// the version. tools/aeris_telemetry.py is the matching host-side decoder.
+static const uint16_t kStateBinSchemaVersion = 1;
+static const uint16_t kHistoryBinSchemaVersion = 1;
+static const size_t kTelemetryHeaderSize = 8;
+static const size_t kStateBinSize = kTelemetryHeaderSize + 56;
+static const size_t kHistoryBinMaxSize = kTelemetryHeaderSize + 8 + kPmHistoryLength * 2;
+
+// state.bin payload:
+//   u32 uptime_s, u32 sensor_age_ms, u16 pm25, u16 pm10, u8 fan_percent,
+//   u8 flags (bit0 lights_on, bit1 screen_light_on, bit2 wifi_ready,
+//   bit3 mqtt_connected, bit4 mqtt_enabled), u16 reserved,
+//   u32 wifi_reconnect_count, u32 mqtt_reconnect_count, u32 sensor_parse_errors,
+//   u32 command_drop_button_count, u32 command_drop_mqtt_count,
+//   u32 command_drop_web_count, u32 mqtt_publish_drop_count,
+//   u32 display_update_count, u32 display_bytes_total, u32 http_response_count
+size_t encodeStateBin(const DeviceState& state, bool mqtt_enabled, uint32_t now_ms, uint8_t* out, size_t size);
+
+// history.bin payload:
+//   u16 interval_s, u16 count, u32 next_seq, then `count` u16 PM2.5 averages,
+//   oldest first. next_seq is the sequence number the next sample will get.
+size_t encodeHistoryBin(const DeviceState& state, uint8_t* out, size_t size);
@@ -1,5 +1,7 @@
 #include "web_config_server.h"
 
+#include "form_data.h"
+
 #include "../util/string_safety.h"
 
 #include <string.h>
@@ -15,8 +17,14 @@ WebConfigServer::WebConfigServer(int port)
       state_(nullptr),
       sink_(nullptr),
       batch_sink_(nullptr),
-      sink_ctx_(nullptr) {
+      sink_ctx_(nullptr),
+      response_keep_alive_(false),
+      state_changed_(false) {
     g_softap_fallback_ctx = this;
+    settings_upload_.owner = nullptr;
+    for (uint8_t i = 0; i < kMaxConnections; ++i) {
+        resetConnection(connections_[i]);
+    }
 }
 
 void WebConfigServer::init(SettingsV2* settings, SettingsStore* store, DeviceState* state) {
@@ -39,12 +47,18 @@ void WebConfigServer::begin() {
 }
 
 void WebConfigServer::tick() {
-    TCPClient client = server_.available();
-    if (!client) {
-        return;
+    uint32_t now_ms = millis();
+    acceptConnections(now_ms);
+    for (uint8_t i = 0; i < kMaxConnections; ++i) {
+        if (connections_[i].state != ConnectionState::Idle) {
+            serviceConnection(connections_[i], now_ms);
+        }
     }
-    handleClient(client);
-    client.stop();
+    state_changed_ = false;
+}
+
+void WebConfigServer::notifyStateChanged() {
+    state_changed_ = true;
 }
 
 void WebConfigServer::softApHandler(const char* url,
@@ -83,25 +97,25 @@ void WebConfigServer::handleSoftApRequest(const char* url,
 
     const char* req = (url == nullptr) ? "" : url;
     if (strncmp(req, "/save", 5) == 0) {
-        char ssid[sizeof(settings_->wifi_ssid)] = {0};
-        char pass[sizeof(settings_->wifi_pass)] = {0};
-        const char* form_data = req;
-        const char* query = strchr(req, '?');
-        if (query != nullptr && *(query + 1) != '\0') {
-            form_data = query + 1;
-        }
-
-        bool has_ssid = getParam(form_data, "s", ssid, sizeof(ssid));
-        getParam(form_data, "p", pass, sizeof(pass));
-
-        if (!has_ssid || ssid[0] == '\0') {
+        // The URL is read-only, so the query is copied once and tokenized in place.
+        // Sized for fully percent-encoded credentials.
+        char query[3 * (sizeof(settings_->wifi_ssid) + sizeof(settings_->wifi_pass)) + 8] = {0};
+        const char* query_start = strchr(req, '?');
+        safeCopy(query, sizeof(query), (query_start != nullptr) ? query_start + 1 : "");
+
+        FormData form;
+        form.parse(query);
+        const char* ssid = form.get(FormField::SetupSsid);
+        const char* pass = form.get(FormField::SetupPass);
+
+        if (ssid == nullptr || ssid[0] == '\0') {
             cb(cbArg, 0, 400, "text/plain", nullptr);
             result->write("missing_ssid");
             return;
         }
 
         safeCopy(settings_->wifi_ssid, sizeof(settings_->wifi_ssid), ssid);
-        safeCopy(settings_->wifi_pass, sizeof(settings_->wifi_pass), pass);
+        safeCopy(settings_->wifi_pass, sizeof(settings_->wifi_pass), (pass != nullptr) ? pass : "");
         store_->sanitize(*settings_);
         store_->save(*settings_);
 
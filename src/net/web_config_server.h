@@ -3,9 +3,13 @@
 #include "Particle.h"
 #include "softap_http.h"
 
+#include "form_data.h"
+#include "response_writer.h"
+
 #include "../app/command.h"
 #include "../core/device_state.h"
 #include "../core/settings_store.h"
+#include "../util/json_writer.h"
 
 class WebConfigServer {
 public:
@@ -19,6 +23,7 @@ public:
     void setCommandBatchSink(CommandBatchSink sink);
     void begin();
     void tick();
+    void notifyStateChanged();
 
     static void softApHandler(const char* url,
                               ResponseCallback* cb,
@@ -28,6 +33,103 @@ public:
                               void* reserved);
 
 private:
+    static const uint8_t kMaxConnections = 3;
+    static const size_t kRequestBufferSize = 1536;
+    // Upper bound for bodies streamed to a route's body handler.
+    static const size_t kMaxStreamedBodyLength = 4096;
+
+    enum class ConnectionState : uint8_t {
+        Idle = 0,
+        ReadingHead,
+        ReadingBody,
+        EventStream,
+        WebSocket,
+    };
+
+    enum class ControlParseResult : uint8_t {
+        Ok = 0,
+        MissingFields,
+        Invalid,
+    };
+
+    // Last values pushed on an event stream; only fields that differ are resent.
+    struct StreamSnapshot {
+        int fan_percent;
+        int pm25;
+        int pm10;
+        uint32_t sensor_parse_errors;
+        bool lights_on;
+        bool screen_light_on;
+        bool wifi_ready;
+        bool mqtt_connected;
+        bool mqtt_enabled;
+    };
+
+    // One accepted socket; bytes accumulate across ticks until the request is complete.
+    struct Connection {
+        TCPClient client;
+        ConnectionState state;
+        char buf[kRequestBufferSize];
+        size_t len;
+        size_t scan_pos;
+        uint8_t terminator_match;
+        size_t body_offset;
+        size_t content_length;
+        // Routes with a body handler get the body in chunks instead of buffered whole.
+        bool body_streaming;
+        size_t body_remaining;
+        size_t body_received;
+        uint8_t route;
+        char* method;
+        char* path;
+        char* query;
+        const char* if_none_match;
+        const char* websocket_key;
+        const char* websocket_version;
+        bool accepts_gzip;
+        bool keep_alive;
+        uint8_t requests_served;
+        uint32_t last_activity_ms;
+        // WebSocket only: the last frame from the peer and the last ping sent.
+        uint32_t last_rx_ms;
+        uint32_t last_ping_ms;
+        StreamSnapshot sent;
+    };
+
+    typedef void (WebConfigServer::*RouteHandler)(Connection& conn);
+    // Receives one bounded chunk of a POST body, in order. Returning false means
+    // the handler already responded with an error and the connection is dropped.
+    typedef bool (WebConfigServer::*BodyHandler)(Connection& conn, char* chunk, size_t len);
+
+    // Handlers for one path, by method; nullptr means the method gets 405.
+    // With a body handler, `post` runs after the last chunk to send the response.
+    struct RouteHandlers {
+        RouteHandler get;
+        RouteHandler post;
+        BodyHandler body;
+    };
+
+    // Settings POST staged field by field while its body streams in; committed
+    // only if every field validates. One upload at a time.
+    struct SettingsUpload {
+        Connection* owner;
+        SettingsV2 pending;
+        FormStreamParser parser;
+        // Fields already seen, by FormField bit: like FormData, the first
+        // occurrence of a repeated key wins and later ones are ignored.
+        uint32_t seen;
+        bool has_device_id;
+        bool has_topic_root;
+        char errors[128];
+    };
+
+    // Indexed by the route ids in web_config_server_routes.cpp.
+    static const RouteHandlers kRouteHandlers[];
+    static const uint8_t kNoRoute = 0xFF;
+    // body_len for a response that turns the connection into a stream: no
+    // Content-Length, and extra_headers supply the Connection header.
+    static const size_t kStreamBody = static_cast<size_t>(-1);
+
     TCPServer server_;
     SettingsV2* settings_;
     SettingsStore* store_;
@@ -35,8 +137,26 @@ private:
     CommandSink sink_;
     CommandBatchSink batch_sink_;
     void* sink_ctx_;
+    Connection connections_[kMaxConnections];
+    ResponseWriter response_;
+    SettingsUpload settings_upload_;
+    bool response_keep_alive_;
+    bool state_changed_;
 
-    void handleClient(TCPClient& client);
+    void acceptConnections(uint32_t now_ms);
+    void serviceConnection(Connection& conn, uint32_t now_ms);
+    void processBufferedRequests(Connection& conn);
+    uint8_t activeConnectionCount() const;
+    void resetConnection(Connection& conn);
+    void closeConnection(Connection& conn);
+    bool scanForHeadEnd(Connection& conn);
+    bool parseRequestHead(Connection& conn);
+    void resolveRoute(Connection& conn);
+    bool prepareBody(Connection& conn);
+    bool consumeStreamedBody(Connection& conn);
+    void handleRequest(Connection& conn);
+    void respondMethodNotAllowed(Connection& conn, const RouteHandlers& handlers);
+    char* requestForm(Connection& conn);
     void handleSoftApRequest(const char* url,
                              ResponseCallback* cb,
                              void* cbArg,
@@ -44,16 +164,53 @@ private:
                              Writer* result,
                              void* reserved);
 
-    size_t urlDecode(const char* src, size_t src_len, char* dst, size_t dst_size) const;
-    bool getParam(const char* data, const char* key, char* out, size_t out_size) const;
-
     void respond(TCPClient& client, int status, const char* content_type, const char* body);
-    void respondN(TCPClient& client, int status, const char* content_type, const char* body, size_t body_len);
-    void handleApiSettingsGet(TCPClient& client);
-    void handleApiSettingsPost(TCPClient& client, const char* form_data);
-    void handleApiStateGet(TCPClient& client);
-    void handleApiControlPost(TCPClient& client, const char* form_data);
-    void handleApiSystemReboot(TCPClient& client);
-    void handleApiSystemDfu(TCPClient& client);
+    void respondN(TCPClient& client,
+                  int status,
+                  const char* content_type,
+                  const char* body,
+                  size_t body_len,
+                  const char* extra_headers = nullptr);
+    void writeResponseHead(TCPClient& client,
+                           int status,
+                           const char* content_type,
+                           size_t body_len,
+                           const char* extra_headers);
+    void finishResponse();
+    template <typename Source, size_t N>
+    void respondJson(TCPClient& client, int status, const JsonField<Source> (&fields)[N], const Source& source);
+    void handleIndexGet(Connection& conn);
+    void handleApiSettingsGet(Connection& conn);
+    void handleApiSettingsPost(Connection& conn);
+    bool handleApiSettingsBody(Connection& conn, char* chunk, size_t len);
+    bool beginSettingsUpload(Connection& conn);
+    static void onSettingsField(void* ctx, FormField field, const char* value, bool truncated);
+    void applySettingsField(FormField field, const char* value, bool truncated);
+    void handleApiStateGet(Connection& conn);
+    void handleApiStateBinGet(Connection& conn);
+    void handleApiHistoryBinGet(Connection& conn);
+    void handleMetricsGet(Connection& conn);
+    void handleApiEventsGet(Connection& conn);
+    void handleApiWebSocketGet(Connection& conn);
+    bool reserveStreamSlot(Connection& conn);
+    void serviceEventStream(Connection& conn, uint32_t now_ms);
+    void serviceWebSocket(Connection& conn, uint32_t now_ms);
+    bool handleWebSocketFrames(Connection& conn);
+    void handleWebSocketText(Connection& conn, char* text);
+    bool sendWebSocketFrame(Connection& conn, uint8_t opcode, const char* payload, size_t len);
+    bool pushStateEvent(Connection& conn, bool full);
+    size_t buildStateDelta(Connection& conn, bool full, char* out, size_t out_size);
+    void captureSnapshot(StreamSnapshot& out) const;
+    void handleApiControlPost(Connection& conn);
+    void handleApiControlBatchPost(Connection& conn);
+    // Tokenizes form_data in place.
+    ControlParseResult parseControlCommands(char* form_data,
+                                            Command* commands,
+                                            size_t& count,
+                                            char* errors,
+                                            size_t errors_size) const;
+    const char* submitCommands(const Command* commands, size_t count);
+    void handleApiSystemReboot(Connection& conn);
+    void handleApiSystemDfu(Connection& conn);
     bool pushCommand(CommandType type, int value, CommandSource source);
 };
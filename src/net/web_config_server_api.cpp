@@ -1,5 +1,9 @@
 #include "web_config_server.h"
 
+#include "form_data.h"
+#include "metrics_exposition.h"
+#include "telemetry_codec.h"
+
 #include "../util/parse_int.h"
 #include "../util/string_safety.h"
 #include "../util/topic_validation.h"
@@ -17,192 +21,386 @@ void appendErrorField(char* errors, size_t size, const char* field_name) {
     }
     strncat(errors, field_name, size - strlen(errors) - 1);
 }
+const JsonField<SettingsV2> kSettingsFields[] = {
+    {"wifi_ssid", [](const SettingsV2& s) { return jsonString(s.wifi_ssid); }},
+    {"mqtt_enabled", [](const SettingsV2& s) { return jsonUInt(s.mqtt_enabled); }},
+    {"mqtt_host", [](const SettingsV2& s) { return jsonString(s.mqtt_host); }},
+    {"mqtt_port", [](const SettingsV2& s) { return jsonUInt(s.mqtt_port); }},
+    {"mqtt_user", [](const SettingsV2& s) { return jsonString(s.mqtt_user); }},
+    {"device_id", [](const SettingsV2& s) { return jsonString(s.device_id); }},
+    {"mqtt_topic_root", [](const SettingsV2& s) { return jsonString(s.mqtt_topic_root); }},
+    {"mqtt_publish_mode", [](const SettingsV2& s) { return jsonUInt(s.mqtt_publish_mode); }},
+    {"fan_font_size", [](const SettingsV2& s) { return jsonInt(s.fan_font_size); }},
+    {"fan_x", [](const SettingsV2& s) { return jsonInt(s.fan_x); }},
+    {"fan_y", [](const SettingsV2& s) { return jsonInt(s.fan_y); }},
+    {"pm_font_size", [](const SettingsV2& s) { return jsonInt(s.pm_font_size); }},
+    {"pm_x", [](const SettingsV2& s) { return jsonInt(s.pm_x); }},
+    {"pm_y", [](const SettingsV2& s) { return jsonInt(s.pm_y); }},
+};
+
+struct StateJsonSource {
+    const DeviceState* state;
+    bool mqtt_enabled;
+    uint32_t now_ms;
+};
+
+template <MetricId id>
+JsonValue readMetric(const StateJsonSource& s) {
+    return jsonUInt(s.state->metrics.get(id));
+}
+
+const JsonField<StateJsonSource> kStateFields[] = {
+    {"fan_percent", [](const StateJsonSource& s) { return jsonInt(s.state->fan_percent); }},
+    {"lights_on", [](const StateJsonSource& s) { return jsonBool(s.state->lights_on); }},
+    {"screen_light_on", [](const StateJsonSource& s) { return jsonBool(s.state->screen_light_on); }},
+    {"pm25", [](const StateJsonSource& s) { return jsonInt(s.state->pm25_smooth); }},
+    {"pm10", [](const StateJsonSource& s) { return jsonInt(s.state->pm10_smooth); }},
+    {"wifi_ready", [](const StateJsonSource& s) { return jsonBool(s.state->wifi_ready); }},
+    {"mqtt_connected", [](const StateJsonSource& s) { return jsonBool(s.state->mqtt_connected); }},
+    {"mqtt_enabled", [](const StateJsonSource& s) { return jsonBool(s.mqtt_enabled); }},
+    {"uptime_s", [](const StateJsonSource& s) { return jsonUInt((s.now_ms - s.state->boot_ms) / 1000); }},
+    {"sensor_parse_errors", &readMetric<MetricId::SensorParseErrors>},
+    {"sensor_age_ms", [](const StateJsonSource& s) { return jsonUInt(s.now_ms - s.state->last_sensor_packet_ms); }},
+    {"command_drop_button_count", &readMetric<MetricId::CommandDropsButton>},
+    {"command_drop_mqtt_count", &readMetric<MetricId::CommandDropsMqtt>},
+    {"command_drop_web_count", &readMetric<MetricId::CommandDropsWeb>},
+    {"mqtt_publish_drop_count", &readMetric<MetricId::MqttPublishDrops>},
+    {"mqtt_publish_count", &readMetric<MetricId::MqttPublishes>},
+    {"mqtt_publish_rate", &readMetric<MetricId::MqttPublishRate>},
+    {"heap_free", &readMetric<MetricId::HeapFree>},
+    {"heap_max_used", &readMetric<MetricId::HeapMaxUsed>},
+    {"heap_largest_free_block", &readMetric<MetricId::HeapLargestFreeBlock>},
+    {"heap_fragmentation_pct", &readMetric<MetricId::HeapFragmentation>},
+    {"display_update_count", &readMetric<MetricId::DisplayUpdates>},
+    {"display_last_update_bytes", &readMetric<MetricId::DisplayLastUpdateBytes>},
+    {"display_bytes_total", &readMetric<MetricId::DisplayBytes>},
+    {"http_response_count", &readMetric<MetricId::HttpResponses>},
+    {"http_last_response_bytes", &readMetric<MetricId::HttpLastResponseBytes>},
+    {"http_last_response_segments", &readMetric<MetricId::HttpLastResponseSegments>},
+    {"http_response_bytes_total", &readMetric<MetricId::HttpResponseBytes>},
+    {"http_response_segments_total", &readMetric<MetricId::HttpResponseSegments>},
+};
 }  // namespace
 
-void WebConfigServer::handleApiSettingsGet(TCPClient& client) {
-    char json[832];
-    int written = snprintf(
-        json,
-        sizeof(json),
-        "{\"wifi_ssid\":\"%s\",\"mqtt_enabled\":%u,\"mqtt_host\":\"%s\",\"mqtt_port\":%u,\"mqtt_user\":\"%s\",\"device_id\":\"%s\",\"mqtt_topic_root\":\"%s\",\"fan_font_size\":%d,\"fan_x\":%d,\"fan_y\":%d,\"pm_font_size\":%d,\"pm_x\":%d,\"pm_y\":%d}",
-        settings_->wifi_ssid,
-        static_cast<unsigned>(settings_->mqtt_enabled),
-        settings_->mqtt_host,
-        settings_->mqtt_port,
-        settings_->mqtt_user,
-        settings_->device_id,
-        settings_->mqtt_topic_root,
-        settings_->fan_font_size,
-        settings_->fan_x,
-        settings_->fan_y,
-        settings_->pm_font_size,
-        settings_->pm_x,
-        settings_->pm_y);
-
-    size_t body_len = (written < 0) ? 0 : static_cast<size_t>(written);
-    if (body_len >= sizeof(json)) {
-        body_len = sizeof(json) - 1;
+template <typename Source, size_t N>
+void WebConfigServer::respondJson(TCPClient& client,
+                                  int status,
+                                  const JsonField<Source> (&fields)[N],
+                                  const Source& source) {
+    CountingSink counter;
+    JsonWriter<CountingSink> measure(counter);
+    measure.writeObject(fields, source);
+
+    writeResponseHead(client, status, "application/json", counter.count(), nullptr);
+    JsonWriter<ResponseWriter> writer(response_);
+    writer.writeObject(fields, source);
+    finishResponse();
+}
+
+void WebConfigServer::handleApiSettingsGet(Connection& conn) {
+    TCPClient& client = conn.client;
+    respondJson(client, 200, kSettingsFields, *settings_);
+}
+
+bool WebConfigServer::beginSettingsUpload(Connection& conn) {
+    if (settings_upload_.owner != nullptr && settings_upload_.owner != &conn) {
+        respond(conn.client, 503, "application/json", "{\"error\":\"settings_upload_busy\"}");
+        return false;
     }
-    respondN(client, 200, "application/json", json, body_len);
+    SettingsUpload& upload = settings_upload_;
+    upload.owner = &conn;
+    upload.pending = *settings_;
+    upload.parser.begin(&WebConfigServer::onSettingsField, this);
+    upload.seen = 0;
+    upload.has_device_id = false;
+    upload.has_topic_root = false;
+    upload.errors[0] = '\0';
+    return true;
 }
 
-void WebConfigServer::handleApiSettingsPost(TCPClient& client, const char* form_data) {
-    char errors[128] = {0};
-    char value[128] = {0};
-    char device_id_candidate[sizeof(settings_->device_id)] = {0};
-    char topic_root_candidate[sizeof(settings_->mqtt_topic_root)] = {0};
+bool WebConfigServer::handleApiSettingsBody(Connection& conn, char* chunk, size_t len) {
+    if (conn.body_received == 0 && !beginSettingsUpload(conn)) {
+        return false;
+    }
+    settings_upload_.parser.feed(chunk, len);
+    return true;
+}
 
-    int port_value = settings_->mqtt_port;
-    int mqtt_enabled_value = settings_->mqtt_enabled ? 1 : 0;
-    int fan_font_value = settings_->fan_font_size;
-    int pm_font_value = settings_->pm_font_size;
+void WebConfigServer::onSettingsField(void* ctx, FormField field, const char* value, bool truncated) {
+    static_cast<WebConfigServer*>(ctx)->applySettingsField(field, value, truncated);
+}
 
-    if (getParam(form_data, "mqtt_port", value, sizeof(value))) {
-        if (!parseIntStrict(value, 1, 65535, port_value)) {
-            appendErrorField(errors, sizeof(errors), "mqtt_port");
-        }
+void WebConfigServer::applySettingsField(FormField field, const char* value, bool truncated) {
+    static_assert(static_cast<size_t>(FormField::Count) <= 32, "seen bitmap holds 32 fields");
+    SettingsUpload& upload = settings_upload_;
+    SettingsV2& pending = upload.pending;
+    uint32_t bit = 1UL << static_cast<uint8_t>(field);
+    if ((upload.seen & bit) != 0) {
+        return;
     }
-    if (getParam(form_data, "mqtt_enabled", value, sizeof(value))) {
-        if (!parseIntStrict(value, 0, 1, mqtt_enabled_value)) {
-            appendErrorField(errors, sizeof(errors), "mqtt_enabled");
-        }
+    upload.seen |= bit;
+    if (truncated) {
+        appendErrorField(upload.errors, sizeof(upload.errors), formFieldName(field));
+        return;
     }
 
-    if (getParam(form_data, "fan_font_size", value, sizeof(value))) {
-        if (!parseIntStrict(value, 1, 12, fan_font_value)) {
-            appendErrorField(errors, sizeof(errors), "fan_font_size");
-        }
+    int parsed = 0;
+    bool valid = true;
+    switch (field) {
+        case FormField::MqttPort:
+            valid = parseIntStrict(value, 1, 65535, parsed);
+            if (valid) {
+                pending.mqtt_port = static_cast<uint16_t>(parsed);
+            }
+            break;
+        case FormField::MqttEnabled:
+            valid = parseIntStrict(value, 0, 1, parsed);
+            if (valid) {
+                pending.mqtt_enabled = static_cast<uint8_t>(parsed);
+            }
+            break;
+        case FormField::MqttPublishMode:
+            valid = parseIntStrict(value, static_cast<int>(MqttPublishMode::PerTopic),
+                                   static_cast<int>(MqttPublishMode::Aggregate), parsed);
+            if (valid) {
+                pending.mqtt_publish_mode = static_cast<uint8_t>(parsed);
+            }
+            break;
+        case FormField::FanFontSize:
+            valid = parseIntStrict(value, 1, 12, parsed);
+            if (valid) {
+                pending.fan_font_size = static_cast<int16_t>(parsed);
+            }
+            break;
+        case FormField::PmFontSize:
+            valid = parseIntStrict(value, 1, 12, parsed);
+            if (valid) {
+                pending.pm_font_size = static_cast<int16_t>(parsed);
+            }
+            break;
+        case FormField::WifiSsid:
+            safeCopy(pending.wifi_ssid, sizeof(pending.wifi_ssid), value);
+            break;
+        case FormField::WifiPass:
+            safeCopy(pending.wifi_pass, sizeof(pending.wifi_pass), value);
+            break;
+        case FormField::MqttHost:
+            safeCopy(pending.mqtt_host, sizeof(pending.mqtt_host), value);
+            break;
+        case FormField::MqttUser:
+            safeCopy(pending.mqtt_user, sizeof(pending.mqtt_user), value);
+            break;
+        case FormField::MqttPass:
+            safeCopy(pending.mqtt_pass, sizeof(pending.mqtt_pass), value);
+            break;
+        // An over-long id or root is rejected rather than silently truncated
+        // into a different topic.
+        case FormField::DeviceId:
+            valid = strlen(value) < sizeof(pending.device_id);
+            if (valid) {
+                safeCopy(pending.device_id, sizeof(pending.device_id), value);
+                upload.has_device_id = true;
+            }
+            break;
+        case FormField::MqttTopicRoot:
+            valid = strlen(value) < sizeof(pending.mqtt_topic_root);
+            if (valid) {
+                safeCopy(pending.mqtt_topic_root, sizeof(pending.mqtt_topic_root), value);
+                upload.has_topic_root = true;
+            }
+            break;
+        // Layout fields keep their old value when unparsable, as before.
+        case FormField::FanX:
+            if (parseIntStrict(value, -32768, 32767, parsed)) {
+                pending.fan_x = static_cast<int16_t>(parsed);
+            }
+            break;
+        case FormField::FanY:
+            if (parseIntStrict(value, -32768, 32767, parsed)) {
+                pending.fan_y = static_cast<int16_t>(parsed);
+            }
+            break;
+        case FormField::PmX:
+            if (parseIntStrict(value, -32768, 32767, parsed)) {
+                pending.pm_x = static_cast<int16_t>(parsed);
+            }
+            break;
+        case FormField::PmY:
+            if (parseIntStrict(value, -32768, 32767, parsed)) {
+                pending.pm_y = static_cast<int16_t>(parsed);
+            }
+            break;
+        case FormField::FanColor:
+            if (parseIntStrict(value, 0, 65535, parsed)) {
+                pending.fan_color = static_cast<uint16_t>(parsed);
+            }
+            break;
+        case FormField::PmLabelColor:
+            if (parseIntStrict(value, 0, 65535, parsed)) {
+                pending.pm_label_color = static_cast<uint16_t>(parsed);
+            }
+            break;
+        case FormField::PmValueColor:
+            if (parseIntStrict(value, 0, 65535, parsed)) {
+                pending.pm_value_color = static_cast<uint16_t>(parsed);
+            }
+            break;
+        default:
+            break;
+    }
+    if (!valid) {
+        appendErrorField(upload.errors, sizeof(upload.errors), formFieldName(field));
     }
+}
 
-    if (getParam(form_data, "pm_font_size", value, sizeof(value))) {
-        if (!parseIntStrict(value, 1, 12, pm_font_value)) {
-            appendErrorField(errors, sizeof(errors), "pm_font_size");
+// Runs after the whole body went through handleApiSettingsBody; an empty body
+// falls back to the query string.
+void WebConfigServer::handleApiSettingsPost(Connection& conn) {
+    TCPClient& client = conn.client;
+    SettingsUpload& upload = settings_upload_;
+    if (upload.owner != &conn) {
+        if (!beginSettingsUpload(conn)) {
+            return;
+        }
+        if (conn.query != nullptr) {
+            upload.parser.feed(conn.query, strlen(conn.query));
         }
     }
+    upload.parser.finish();
+    upload.owner = nullptr;
 
-    bool has_device_id = getParam(form_data, "device_id", device_id_candidate, sizeof(device_id_candidate));
-    if (mqtt_enabled_value != 0 && has_device_id &&
-        !isDeviceIdTopicSafe(device_id_candidate, sizeof(device_id_candidate) - 1)) {
-        appendErrorField(errors, sizeof(errors), "device_id");
+    SettingsV2& pending = upload.pending;
+    // Topic checks depend on mqtt_enabled, which may arrive after the id in the body.
+    if (pending.mqtt_enabled != 0 && upload.has_device_id &&
+        !isDeviceIdTopicSafe(pending.device_id, sizeof(pending.device_id) - 1)) {
+        appendErrorField(upload.errors, sizeof(upload.errors), "device_id");
     }
-
-    bool has_topic_root =
-        getParam(form_data, "mqtt_topic_root", topic_root_candidate, sizeof(topic_root_candidate));
-    if (mqtt_enabled_value != 0 && has_topic_root && topic_root_candidate[0] != '\0' &&
-        !isTopicRootSafe(topic_root_candidate, sizeof(topic_root_candidate))) {
-        appendErrorField(errors, sizeof(errors), "mqtt_topic_root");
+    if (pending.mqtt_enabled != 0 && upload.has_topic_root && pending.mqtt_topic_root[0] != '\0' &&
+        !isTopicRootSafe(pending.mqtt_topic_root, sizeof(pending.mqtt_topic_root))) {
+        appendErrorField(upload.errors, sizeof(upload.errors), "mqtt_topic_root");
     }
 
-    if (errors[0] != '\0') {
+    if (upload.errors[0] != '\0') {
         char body[192];
         snprintf(body,
                  sizeof(body),
                  "{\"error\":\"validation_failed\",\"fields\":\"%s\"}",
-                 errors);
+                 upload.errors);
         respond(client, 400, "application/json", body);
         return;
     }
 
-    if (getParam(form_data, "wifi_ssid", value, sizeof(value))) {
-        safeCopy(settings_->wifi_ssid, sizeof(settings_->wifi_ssid), value);
-    }
-    if (getParam(form_data, "wifi_pass", value, sizeof(value))) {
-        safeCopy(settings_->wifi_pass, sizeof(settings_->wifi_pass), value);
-    }
-    if (getParam(form_data, "mqtt_host", value, sizeof(value))) {
-        safeCopy(settings_->mqtt_host, sizeof(settings_->mqtt_host), value);
-    }
-    if (getParam(form_data, "mqtt_user", value, sizeof(value))) {
-        safeCopy(settings_->mqtt_user, sizeof(settings_->mqtt_user), value);
-    }
-    if (getParam(form_data, "mqtt_pass", value, sizeof(value))) {
-        safeCopy(settings_->mqtt_pass, sizeof(settings_->mqtt_pass), value);
-    }
-    if (has_device_id) {
-        safeCopy(settings_->device_id, sizeof(settings_->device_id), device_id_candidate);
-    }
-    if (has_topic_root) {
-        safeCopy(settings_->mqtt_topic_root, sizeof(settings_->mqtt_topic_root), topic_root_candidate);
-    }
+    *settings_ = pending;
+    store_->sanitize(*settings_);
+    store_->save(*settings_);
 
-    int parsed = 0;
-    if (getParam(form_data, "fan_x", value, sizeof(value)) && parseIntStrict(value, -32768, 32767, parsed)) {
-        settings_->fan_x = static_cast<int16_t>(parsed);
-    }
-    if (getParam(form_data, "fan_y", value, sizeof(value)) && parseIntStrict(value, -32768, 32767, parsed)) {
-        settings_->fan_y = static_cast<int16_t>(parsed);
-    }
-    if (getParam(form_data, "pm_x", value, sizeof(value)) && parseIntStrict(value, -32768, 32767, parsed)) {
-        settings_->pm_x = static_cast<int16_t>(parsed);
-    }
-    if (getParam(form_data, "pm_y", value, sizeof(value)) && parseIntStrict(value, -32768, 32767, parsed)) {
-        settings_->pm_y = static_cast<int16_t>(parsed);
-    }
-    if (getParam(form_data, "fan_color", value, sizeof(value)) && parseIntStrict(value, 0, 65535, parsed)) {
-        settings_->fan_color = static_cast<uint16_t>(parsed);
-    }
-    if (getParam(form_data, "pm_label_color", value, sizeof(value)) && parseIntStrict(value, 0, 65535, parsed)) {
-        settings_->pm_label_color = static_cast<uint16_t>(parsed);
+    respond(client, 200, "application/json", "{\"ok\":true,\"reboot_required\":true}");
+}
+
+void WebConfigServer::handleApiStateGet(Connection& conn) {
+    TCPClient& client = conn.client;
+    if (state_ == nullptr) {
+        respond(client, 500, "application/json", "{\"error\":\"state_unavailable\"}");
+        return;
     }
-    if (getParam(form_data, "pm_value_color", value, sizeof(value)) && parseIntStrict(value, 0, 65535, parsed)) {
-        settings_->pm_value_color = static_cast<uint16_t>(parsed);
+
+    StateJsonSource source;
+    source.state = state_;
+    source.mqtt_enabled = (settings_ != nullptr && settings_->mqtt_enabled != 0);
+    source.now_ms = millis();
+    respondJson(client, 200, kStateFields, source);
+}
+
+void WebConfigServer::handleApiStateBinGet(Connection& conn) {
+    if (state_ == nullptr) {
+        respond(conn.client, 500, "application/json", "{\"error\":\"state_unavailable\"}");
+        return;
     }
 
-    settings_->mqtt_port = static_cast<uint16_t>(port_value);
-    settings_->mqtt_enabled = static_cast<uint8_t>(mqtt_enabled_value);
-    settings_->fan_font_size = static_cast<int16_t>(fan_font_value);
-    settings_->pm_font_size = static_cast<int16_t>(pm_font_value);
+    uint8_t record[kStateBinSize];
+    bool mqtt_enabled = (settings_ != nullptr && settings_->mqtt_enabled != 0);
+    size_t len = encodeStateBin(*state_, mqtt_enabled, millis(), record, sizeof(record));
+    char headers[64];
+    snprintf(headers,
+             sizeof(headers),
+             "X-Aeris-Schema: state/%u\r\nCache-Control: no-store\r\n",
+             static_cast<unsigned>(kStateBinSchemaVersion));
+    respondN(conn.client, 200, "application/octet-stream", reinterpret_cast<const char*>(record), len, headers);
+}
 
-    store_->sanitize(*settings_);
-    store_->save(*settings_);
+void WebConfigServer::handleApiHistoryBinGet(Connection& conn) {
+    if (state_ == nullptr) {
+        respond(conn.client, 500, "application/json", "{\"error\":\"state_unavailable\"}");
+        return;
+    }
 
-    respond(client, 200, "application/json", "{\"ok\":true,\"reboot_required\":true}");
+    uint8_t record[kHistoryBinMaxSize];
+    size_t len = encodeHistoryBin(*state_, record, sizeof(record));
+    char headers[64];
+    snprintf(headers,
+             sizeof(headers),
+             "X-Aeris-Schema: history/%u\r\nCache-Control: no-store\r\n",
+             static_cast<unsigned>(kHistoryBinSchemaVersion));
+    respondN(conn.client, 200, "application/octet-stream", reinterpret_cast<const char*>(record), len, headers);
 }
 
-void WebConfigServer::handleApiStateGet(TCPClient& client) {
+void WebConfigServer::handleMetricsGet(Connection& conn) {
     if (state_ == nullptr) {
-        respond(client, 500, "application/json", "{\"error\":\"state_unavailable\"}");
+        respond(conn.client, 500, "text/plain", "state_unavailable");
         return;
     }
 
-    char json[512];
+    // One timestamp for both passes so the measured length matches the body.
     uint32_t now_ms = millis();
-    uint32_t uptime_s = (now_ms - state_->boot_ms) / 1000;
-    uint32_t sensor_age_ms = now_ms - state_->last_sensor_packet_ms;
-    uint32_t mqtt_enabled = (settings_ != nullptr && settings_->mqtt_enabled != 0) ? 1 : 0;
-
-    int written = snprintf(json,
-                           sizeof(json),
-                           "{\"fan_percent\":%d,\"lights_on\":%d,\"screen_light_on\":%d,\"pm25\":%d,\"pm10\":%d,"
-                           "\"wifi_ready\":%d,\"mqtt_connected\":%d,\"mqtt_enabled\":%lu,\"uptime_s\":%lu,"
-                           "\"sensor_parse_errors\":%lu,\"sensor_age_ms\":%lu,"
-                           "\"command_drop_button_count\":%lu,\"command_drop_mqtt_count\":%lu,"
-                           "\"command_drop_web_count\":%lu,\"mqtt_publish_drop_count\":%lu}",
-                           state_->fan_percent,
-                           state_->lights_on ? 1 : 0,
-                           state_->screen_light_on ? 1 : 0,
-                           state_->pm25_smooth,
-                           state_->pm10_smooth,
-                           state_->wifi_ready ? 1 : 0,
-                           state_->mqtt_connected ? 1 : 0,
-                           static_cast<unsigned long>(mqtt_enabled),
-                           static_cast<unsigned long>(uptime_s),
-                           static_cast<unsigned long>(state_->sensor_parse_errors),
-                           static_cast<unsigned long>(sensor_age_ms),
-                           static_cast<unsigned long>(state_->command_drop_button_count),
-                           static_cast<unsigned long>(state_->command_drop_mqtt_count),
-                           static_cast<unsigned long>(state_->command_drop_web_count),
-                           static_cast<unsigned long>(state_->mqtt_publish_drop_count));
-    size_t body_len = (written < 0) ? 0 : static_cast<size_t>(written);
-    if (body_len >= sizeof(json)) {
-        body_len = sizeof(json) - 1;
-    }
-    respondN(client, 200, "application/json", json, body_len);
+    CountingSink counter;
+    MetricsExposition<CountingSink> measure(counter);
+    measure.write(*state_, now_ms);
+
+    writeResponseHead(conn.client, 200, "text/plain; version=0.0.4", counter.count(), nullptr);
+    MetricsExposition<ResponseWriter> exposition(response_);
+    exposition.write(*state_, now_ms);
+    finishResponse();
 }
 
-void WebConfigServer::handleApiControlPost(TCPClient& client, const char* form_data) {
+void WebConfigServer::handleApiControlPost(Connection& conn) {
+    TCPClient& client = conn.client;
     char errors[64] = {0};
-    char value[32] = {0};
+    Command commands[3];
+    size_t command_count = 0;
+
+    ControlParseResult parsed =
+        parseControlCommands(requestForm(conn), commands, command_count, errors, sizeof(errors));
+    if (parsed == ControlParseResult::MissingFields) {
+        respond(client, 400, "application/json", "{\"error\":\"missing_control_fields\"}");
+        return;
+    }
+    if (parsed == ControlParseResult::Invalid) {
+        char body[128];
+        snprintf(body,
+                 sizeof(body),
+                 "{\"error\":\"validation_failed\",\"fields\":\"%s\"}",
+                 errors);
+        respond(client, 400, "application/json", body);
+        return;
+    }
+
+    const char* error = submitCommands(commands, command_count);
+    if (error != nullptr) {
+        char body[96];
+        snprintf(body, sizeof(body), "{\"error\":\"%s\"}", error);
+        respond(client, 503, "application/json", body);
+        return;
+    }
+    respond(client, 200, "application/json", "{\"ok\":true}");
+}
+
+WebConfigServer::ControlParseResult WebConfigServer::parseControlCommands(char* form_data,
+                                                                          Command* commands,
+                                                                          size_t& count,
+                                                                          char* errors,
+                                                                          size_t errors_size) const {
+    FormData form;
+    form.parse(form_data);
 
     int fan_percent = 0;
     int lights = 0;
@@ -212,86 +410,77 @@ void WebConfigServer::handleApiControlPost(TCPClient& client, const char* form_d
     bool has_lights = false;
     bool has_screen = false;
 
-    if (getParam(form_data, "fan_percent", value, sizeof(value))) {
+    const char* fan_percent_value = form.get(FormField::FanPercent);
+    if (fan_percent_value != nullptr) {
         has_fan = true;
-        if (!parseIntStrict(value, 0, 100, fan_percent)) {
-            appendErrorField(errors, sizeof(errors), "fan_percent");
+        if (!parseIntStrict(fan_percent_value, 0, 100, fan_percent)) {
+            appendErrorField(errors, errors_size, "fan_percent");
         }
     }
-    if (getParam(form_data, "lights", value, sizeof(value))) {
+    const char* lights_value = form.get(FormField::Lights);
+    if (lights_value != nullptr) {
         has_lights = true;
-        if (!parseIntStrict(value, 0, 1, lights)) {
-            appendErrorField(errors, sizeof(errors), "lights");
+        if (!parseIntStrict(lights_value, 0, 1, lights)) {
+            appendErrorField(errors, errors_size, "lights");
         }
     }
-    if (getParam(form_data, "screen_light", value, sizeof(value))) {
+    const char* screen_light_value = form.get(FormField::ScreenLight);
+    if (screen_light_value != nullptr) {
         has_screen = true;
-        if (!parseIntStrict(value, 0, 1, screen_light)) {
-            appendErrorField(errors, sizeof(errors), "screen_light");
+        if (!parseIntStrict(screen_light_value, 0, 1, screen_light)) {
+            appendErrorField(errors, errors_size, "screen_light");
         }
     }
 
+    count = 0;
     if (!has_fan && !has_lights && !has_screen) {
-        respond(client, 400, "application/json", "{\"error\":\"missing_control_fields\"}");
-        return;
+        return ControlParseResult::MissingFields;
     }
     if (errors[0] != '\0') {
-        char body[128];
-        snprintf(body,
-                 sizeof(body),
-                 "{\"error\":\"validation_failed\",\"fields\":\"%s\"}",
-                 errors);
-        respond(client, 400, "application/json", body);
-        return;
+        return ControlParseResult::Invalid;
     }
 
-    Command commands[3];
-    size_t command_count = 0;
-
     if (has_fan) {
-        commands[command_count].type = CommandType::SetFanPercent;
-        commands[command_count].value = fan_percent;
-        commands[command_count].source = CommandSource::Web;
-        ++command_count;
+        commands[count].type = CommandType::SetFanPercent;
+        commands[count].value = fan_percent;
+        commands[count].source = CommandSource::Web;
+        ++count;
     }
     if (has_lights) {
-        commands[command_count].type = CommandType::SetLights;
-        commands[command_count].value = lights;
-        commands[command_count].source = CommandSource::Web;
-        ++command_count;
+        commands[count].type = CommandType::SetLights;
+        commands[count].value = lights;
+        commands[count].source = CommandSource::Web;
+        ++count;
     }
     if (has_screen) {
-        commands[command_count].type = CommandType::SetScreenLight;
-        commands[command_count].value = screen_light;
-        commands[command_count].source = CommandSource::Web;
-        ++command_count;
+        commands[count].type = CommandType::SetScreenLight;
+        commands[count].value = screen_light;
+        commands[count].source = CommandSource::Web;
+        ++count;
     }
+    return ControlParseResult::Ok;
+}
 
+const char* WebConfigServer::submitCommands(const Command* commands, size_t count) {
     bool ok = false;
     if (batch_sink_ != nullptr) {
-        ok = batch_sink_(commands, command_count, sink_ctx_);
-    } else if (command_count == 1) {
+        ok = batch_sink_(commands, count, sink_ctx_);
+    } else if (count == 1) {
         ok = pushCommand(commands[0].type, commands[0].value, commands[0].source);
     } else {
-        respond(client, 503, "application/json", "{\"error\":\"command_batch_unavailable\"}");
-        return;
-    }
-
-    if (!ok) {
-        respond(client, 503, "application/json", "{\"error\":\"command_queue_full\"}");
-        return;
+        return "command_batch_unavailable";
     }
-    respond(client, 200, "application/json", "{\"ok\":true}");
+    return ok ? nullptr : "command_queue_full";
 }
 
-void WebConfigServer::handleApiSystemReboot(TCPClient& client) {
+void WebConfigServer::handleApiSystemReboot(Connection& conn) {
     pushCommand(CommandType::Reboot, 0, CommandSource::Web);
-    respond(client, 200, "application/json", "{\"ok\":true,\"action\":\"reboot\"}");
+    respond(conn.client, 200, "application/json", "{\"ok\":true,\"action\":\"reboot\"}");
 }
 
-void WebConfigServer::handleApiSystemDfu(TCPClient& client) {
+void WebConfigServer::handleApiSystemDfu(Connection& conn) {
     pushCommand(CommandType::EnterDfu, 0, CommandSource::Web);
-    respond(client, 200, "application/json", "{\"ok\":true,\"action\":\"dfu\"}");
+    respond(conn.client, 200, "application/json", "{\"ok\":true,\"action\":\"dfu\"}");
 }
 
 bool WebConfigServer::pushCommand(CommandType type, int value, CommandSource source) {
@@ -0,0 +1,138 @@
+#include "web_config_server.h"
+
+#include "../util/json_tokenizer.h"
+
+#include <stdio.h>
+#include <string.h>
+
+namespace {
+// Leaves headroom in the 16-slot command queue for buttons and MQTT.
+const size_t kMaxBatchCommands = 8;
+// Array + per command: object, two keys, two values. Unknown keys are skipped,
+// so the batch shares slack for them: one extra scalar key on every command,
+// plus a little for nested values.
+const size_t kMaxBatchTokens = 1 + kMaxBatchCommands * 5 + kMaxBatchCommands * 2 + 8;
+
+struct BatchCommandSpec {
+    const char* name;
+    CommandType type;
+    int min_value;
+    int max_value;
+};
+
+const BatchCommandSpec kBatchCommands[] = {
+    {"fan", CommandType::SetFanPercent, 0, 100},
+    {"fan_adjust", CommandType::AdjustFanPercent, -100, 100},
+    {"lights", CommandType::SetLights, 0, 1},
+    {"screen_light", CommandType::SetScreenLight, 0, 1},
+    {"power", CommandType::SetPower, 0, 1},
+};
+
+// Parses one {"type":...,"value":...} element starting at tokens[index].
+// Returns nullptr on success or the per-command result code.
+const char* parseBatchCommand(const char* json, const JsonToken* tokens, int count, int index, Command& out) {
+    const JsonToken& object = tokens[index];
+    if (object.type != JsonTokenType::Object) {
+        return "not_object";
+    }
+
+    const JsonToken* type_token = nullptr;
+    const JsonToken* value_token = nullptr;
+    int key = index + 1;
+    for (uint16_t i = 0; i < object.size && key < count; ++i) {
+        int value = key + 1;
+        if (jsonTokenEquals(json, tokens[key], "type")) {
+            type_token = &tokens[value];
+        } else if (jsonTokenEquals(json, tokens[key], "value")) {
+            value_token = &tokens[value];
+        }
+        key = jsonSkip(tokens, count, value);
+    }
+    if (type_token == nullptr || value_token == nullptr) {
+        return "missing_field";
+    }
+
+    for (size_t i = 0; i < sizeof(kBatchCommands) / sizeof(kBatchCommands[0]); ++i) {
+        const BatchCommandSpec& spec = kBatchCommands[i];
+        if (!jsonTokenEquals(json, *type_token, spec.name)) {
+            continue;
+        }
+        int value = 0;
+        if (!jsonTokenToInt(json, *value_token, spec.min_value, spec.max_value, value)) {
+            return "invalid_value";
+        }
+        out.type = spec.type;
+        out.value = value;
+        out.source = CommandSource::Web;
+        return nullptr;
+    }
+    return "unknown_type";
+}
+
+void appendResults(char* body, size_t size, const char* const* results, size_t count) {
+    size_t len = strlen(body);
+    for (size_t i = 0; i < count && len < size; ++i) {
+        int written = snprintf(body + len, size - len, "%s\"%s\"", (i > 0) ? "," : "", results[i]);
+        if (written > 0) {
+            len += static_cast<size_t>(written);
+        }
+    }
+    if (len < size) {
+        snprintf(body + len, size - len, "]}");
+    }
+}
+}  // namespace
+
+// Body is a JSON array such as [{"type":"fan","value":40},{"type":"lights","value":1}].
+// The batch is queued all-or-nothing; "results" holds one code per command.
+void WebConfigServer::handleApiControlBatchPost(Connection& conn) {
+    const char* json = conn.buf + conn.body_offset;
+    JsonToken tokens[kMaxBatchTokens];
+    int count = jsonTokenize(json, conn.content_length, tokens, kMaxBatchTokens);
+    if (count < 0 || tokens[0].type != JsonTokenType::Array) {
+        respond(conn.client, 400, "application/json", "{\"ok\":false,\"error\":\"invalid_json\"}");
+        return;
+    }
+    size_t command_count = tokens[0].size;
+    if (command_count == 0 || command_count > kMaxBatchCommands) {
+        respond(conn.client, 400, "application/json", "{\"ok\":false,\"error\":\"batch_size\"}");
+        return;
+    }
+
+    Command commands[kMaxBatchCommands];
+    const char* results[kMaxBatchCommands];
+    bool valid = true;
+    int index = 1;
+    for (size_t i = 0; i < command_count; ++i) {
+        results[i] = parseBatchCommand(json, tokens, count, index, commands[i]);
+        if (results[i] != nullptr) {
+            valid = false;
+        }
+        index = jsonSkip(tokens, count, index);
+    }
+
+    char body[256];
+    int status = 200;
+    if (!valid) {
+        status = 400;
+        snprintf(body, sizeof(body), "{\"ok\":false,\"error\":\"validation_failed\",\"results\":[");
+        for (size_t i = 0; i < command_count; ++i) {
+            if (results[i] == nullptr) {
+                results[i] = "valid";
+            }
+        }
+    } else {
+        const char* error = submitCommands(commands, command_count);
+        if (error == nullptr) {
+            snprintf(body, sizeof(body), "{\"ok\":true,\"results\":[");
+        } else {
+            status = 503;
+            snprintf(body, sizeof(body), "{\"ok\":false,\"error\":\"%s\",\"results\":[", error);
+        }
+        for (size_t i = 0; i < command_count; ++i) {
+            results[i] = (error == nullptr) ? "queued" : "not_queued";
+        }
+    }
+    appendResults(body, sizeof(body), results, command_count);
+    respond(conn.client, status, "application/json", body);
+}
@@ -0,0 +1,168 @@
+#include "web_config_server.h"
+
+#include <stdio.h>
+#include <string.h>
+
+namespace {
+const uint32_t kEventHeartbeatMs = 15000;
+const size_t kEventBufferSize = 320;
+
+void appendField(char* buf, size_t size, size_t& len, const char* key, long value) {
+    if (len >= size) {
+        return;
+    }
+    int written = snprintf(buf + len, size - len, "%s\"%s\":%ld", (len > 1) ? "," : "", key, value);
+    if (written > 0) {
+        len += static_cast<size_t>(written);
+    }
+}
+}  // namespace
+
+void WebConfigServer::handleApiEventsGet(Connection& conn) {
+    if (!reserveStreamSlot(conn)) {
+        return;
+    }
+
+    writeResponseHead(conn.client,
+                      200,
+                      "text/event-stream",
+                      kStreamBody,
+                      "Cache-Control: no-cache\r\nConnection: keep-alive\r\n");
+    response_.print("retry: 3000\n\n");
+    finishResponse();
+    conn.state = ConnectionState::EventStream;
+    conn.len = 0;
+    conn.last_activity_ms = millis();
+    pushStateEvent(conn, true);
+}
+
+bool WebConfigServer::reserveStreamSlot(Connection& conn) {
+    if (state_ == nullptr) {
+        respond(conn.client, 500, "application/json", "{\"error\":\"state_unavailable\"}");
+        return false;
+    }
+
+    uint8_t streams = 0;
+    for (uint8_t i = 0; i < kMaxConnections; ++i) {
+        ConnectionState st = connections_[i].state;
+        if (st == ConnectionState::EventStream || st == ConnectionState::WebSocket) {
+            streams += 1;
+        }
+    }
+    // Streams hold their slot for good, so keep one slot for ordinary requests.
+    if (streams + 1 >= kMaxConnections) {
+        response_keep_alive_ = false;
+        conn.keep_alive = false;
+        respond(conn.client, 503, "application/json", "{\"error\":\"stream_limit\"}");
+        return false;
+    }
+    return true;
+}
+
+void WebConfigServer::serviceEventStream(Connection& conn, uint32_t now_ms) {
+    if (!conn.client.connected()) {
+        closeConnection(conn);
+        return;
+    }
+
+    // Nothing is expected from the client; drain so the socket window stays open.
+    uint8_t scratch[32];
+    while (conn.client.available() > 0) {
+        conn.client.read(scratch, sizeof(scratch));
+    }
+
+    if (state_changed_ && !pushStateEvent(conn, false)) {
+        closeConnection(conn);
+        return;
+    }
+
+    if (now_ms - conn.last_activity_ms >= kEventHeartbeatMs) {
+        conn.last_activity_ms = now_ms;
+        static const char kHeartbeat[] = ": ping\n\n";
+        if (conn.client.write(reinterpret_cast<const uint8_t*>(kHeartbeat), sizeof(kHeartbeat) - 1) !=
+            sizeof(kHeartbeat) - 1) {
+            closeConnection(conn);
+        }
+    }
+}
+
+bool WebConfigServer::pushStateEvent(Connection& conn, bool full) {
+    // Leave headroom in front of the JSON for the SSE prefix or a WebSocket frame header.
+    const size_t kPrefixRoom = 8;
+    char event[kEventBufferSize];
+    size_t json_len = buildStateDelta(conn, full, event + kPrefixRoom, sizeof(event) - kPrefixRoom - 2);
+    if (json_len == 0) {
+        return true;
+    }
+    conn.last_activity_ms = millis();
+
+    if (conn.state == ConnectionState::WebSocket) {
+        return sendWebSocketFrame(conn, 0x1, event + kPrefixRoom, json_len);
+    }
+
+    char* start = event + kPrefixRoom - 6;
+    memcpy(start, "data: ", 6);
+    memcpy(event + kPrefixRoom + json_len, "\n\n", 2);
+    size_t len = 6 + json_len + 2;
+    return conn.client.write(reinterpret_cast<const uint8_t*>(start), len) == len;
+}
+
+size_t WebConfigServer::buildStateDelta(Connection& conn, bool full, char* out, size_t out_size) {
+    StreamSnapshot now;
+    captureSnapshot(now);
+    const StreamSnapshot& prev = conn.sent;
+
+    size_t len = 1;
+    out[0] = '{';
+    if (full || now.fan_percent != prev.fan_percent) {
+        appendField(out, out_size, len, "fan_percent", now.fan_percent);
+    }
+    if (full || now.lights_on != prev.lights_on) {
+        appendField(out, out_size, len, "lights_on", now.lights_on ? 1 : 0);
+    }
+    if (full || now.screen_light_on != prev.screen_light_on) {
+        appendField(out, out_size, len, "screen_light_on", now.screen_light_on ? 1 : 0);
+    }
+    if (full || now.pm25 != prev.pm25) {
+        appendField(out, out_size, len, "pm25", now.pm25);
+    }
+    if (full || now.pm10 != prev.pm10) {
+        appendField(out, out_size, len, "pm10", now.pm10);
+    }
+    if (full || now.wifi_ready != prev.wifi_ready) {
+        appendField(out, out_size, len, "wifi_ready", now.wifi_ready ? 1 : 0);
+    }
+    if (full || now.mqtt_connected != prev.mqtt_connected) {
+        appendField(out, out_size, len, "mqtt_connected", now.mqtt_connected ? 1 : 0);
+    }
+    if (full || now.mqtt_enabled != prev.mqtt_enabled) {
+        appendField(out, out_size, len, "mqtt_enabled", now.mqtt_enabled ? 1 : 0);
+    }
+    if (full || now.sensor_parse_errors != prev.sensor_parse_errors) {
+        appendField(out, out_size, len, "sensor_parse_errors", static_cast<long>(now.sensor_parse_errors));
+    }
+    if (len == 1) {
+        return 0;
+    }
+    // Uptime rides along with real changes but never triggers an event by itself.
+    appendField(out, out_size, len, "uptime_s", static_cast<long>((millis() - state_->boot_ms) / 1000));
+    if (len + 1 >= out_size) {
+        return 0;
+    }
+    out[len++] = '}';
+
+    conn.sent = now;
+    return len;
+}
+
+void WebConfigServer::captureSnapshot(StreamSnapshot& out) const {
+    out.fan_percent = state_->fan_percent;
+    out.pm25 = state_->pm25_smooth;
+    out.pm10 = state_->pm10_smooth;
+    out.sensor_parse_errors = state_->metrics.get(MetricId::SensorParseErrors);
+    out.lights_on = state_->lights_on;
+    out.screen_light_on = state_->screen_light_on;
+    out.wifi_ready = state_->wifi_ready;
+    out.mqtt_connected = state_->mqtt_connected;
+    out.mqtt_enabled = (settings_ != nullptr && settings_->mqtt_enabled != 0);
+}
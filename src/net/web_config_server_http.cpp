@@ -3,17 +3,27 @@
 #include "web_ui_html.h"
 
 #include <ctype.h>
+#include <errno.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 namespace {
-const uint32_t kReadTimeoutMs = 120;
-const size_t kRawRequestMax = 1536;
+// A request may trickle in over many ticks; the slot is reclaimed after this much silence.
+const uint32_t kRequestTimeoutMs = 3000;
+const uint32_t kKeepAliveIdleMs = 5000;
+const uint8_t kKeepAliveMaxRequests = 100;
 
 const char* statusReason(int status) {
+    if (status == 101) {
+        return "Switching Protocols";
+    }
     if (status == 200) {
         return "OK";
     }
+    if (status == 304) {
+        return "Not Modified";
+    }
     if (status == 400) {
         return "Bad Request";
     }
@@ -29,6 +39,9 @@ const char* statusReason(int status) {
     if (status == 405) {
         return "Method Not Allowed";
     }
+    if (status == 426) {
+        return "Upgrade Required";
+    }
     if (status == 503) {
         return "Service Unavailable";
     }
@@ -38,64 +51,305 @@ const char* statusReason(int status) {
     return "Error";
 }
 
-int hexToInt(char c) {
-    if (c >= '0' && c <= '9') {
-        return c - '0';
+// Matches "<name>:" case-insensitively and returns the value with leading blanks skipped.
+bool matchHeader(const char* line, const char* lower_name, const char*& value) {
+    size_t i = 0;
+    for (; lower_name[i] != '\0'; ++i) {
+        if (tolower(static_cast<unsigned char>(line[i])) != lower_name[i]) {
+            return false;
+        }
     }
-    if (c >= 'a' && c <= 'f') {
-        return c - 'a' + 10;
+    if (line[i] != ':') {
+        return false;
     }
-    if (c >= 'A' && c <= 'F') {
-        return c - 'A' + 10;
+    value = line + i + 1;
+    while (*value == ' ' || *value == '\t') {
+        ++value;
     }
-    return -1;
+    return true;
 }
-}  // namespace
 
-void WebConfigServer::handleClient(TCPClient& client) {
-    char raw[kRawRequestMax];
-    size_t raw_len = 0;
-    raw[0] = '\0';
+// True when a comma-separated header value lists `lower_token`, ignoring case and blanks.
+bool hasTokenIgnoreCase(const char* value, const char* lower_token) {
+    const char* p = value;
+    while (*p != '\0') {
+        while (*p == ' ' || *p == '\t' || *p == ',') {
+            ++p;
+        }
+        size_t i = 0;
+        while (lower_token[i] != '\0' &&
+               tolower(static_cast<unsigned char>(p[i])) == lower_token[i]) {
+            ++i;
+        }
+        if (lower_token[i] == '\0' && (p[i] == '\0' || p[i] == ',' || p[i] == ' ' || p[i] == '\t')) {
+            return true;
+        }
+        while (*p != '\0' && *p != ',') {
+            ++p;
+        }
+    }
+    return false;
+}
+}  // namespace
 
-    uint32_t start = millis();
-    while (millis() - start < kReadTimeoutMs && raw_len + 1 < sizeof(raw)) {
-        while (client.available() && raw_len + 1 < sizeof(raw)) {
-            raw[raw_len++] = static_cast<char>(client.read());
+void WebConfigServer::acceptConnections(uint32_t now_ms) {
+    for (uint8_t i = 0; i < kMaxConnections; ++i) {
+        Connection& conn = connections_[i];
+        if (conn.state != ConnectionState::Idle) {
+            continue;
         }
-        raw[raw_len] = '\0';
-        if (strstr(raw, "\r\n\r\n") != nullptr) {
-            break;
+        // Extra clients wait in the listen backlog until a slot frees up.
+        TCPClient client = server_.available();
+        if (!client) {
+            return;
         }
+        resetConnection(conn);
+        conn.client = client;
+        conn.state = ConnectionState::ReadingHead;
+        conn.last_activity_ms = now_ms;
+    }
+}
+
+void WebConfigServer::resetConnection(Connection& conn) {
+    conn.state = ConnectionState::Idle;
+    conn.len = 0;
+    conn.scan_pos = 0;
+    conn.terminator_match = 0;
+    conn.body_offset = 0;
+    conn.content_length = 0;
+    conn.body_streaming = false;
+    conn.body_remaining = 0;
+    conn.body_received = 0;
+    conn.route = kNoRoute;
+    conn.method = nullptr;
+    conn.path = nullptr;
+    conn.query = nullptr;
+    conn.if_none_match = nullptr;
+    conn.websocket_key = nullptr;
+    conn.websocket_version = nullptr;
+    conn.accepts_gzip = false;
+    conn.keep_alive = false;
+    conn.requests_served = 0;
+    conn.last_activity_ms = 0;
+    conn.last_rx_ms = 0;
+    conn.last_ping_ms = 0;
+    conn.buf[0] = '\0';
+}
+
+void WebConfigServer::closeConnection(Connection& conn) {
+    if (settings_upload_.owner == &conn) {
+        settings_upload_.owner = nullptr;
     }
+    conn.client.stop();
+    conn.client = TCPClient();
+    resetConnection(conn);
+}
 
-    char* header_end = strstr(raw, "\r\n\r\n");
-    if (header_end == nullptr) {
-        respond(client, 400, "text/plain", "incomplete_header");
+void WebConfigServer::serviceConnection(Connection& conn, uint32_t now_ms) {
+    if (conn.state == ConnectionState::EventStream) {
+        serviceEventStream(conn, now_ms);
+        return;
+    }
+    if (conn.state == ConnectionState::WebSocket) {
+        serviceWebSocket(conn, now_ms);
         return;
     }
 
-    char* line_end = strstr(raw, "\r\n");
-    if (line_end == nullptr) {
-        respond(client, 400, "text/plain", "bad_request");
+    // A full buffer cannot take more bytes, so it waits out the same timeout as
+    // a silent client instead of spinning on available() forever.
+    int available = conn.client.available();
+    size_t space = sizeof(conn.buf) - 1 - conn.len;
+    if (available <= 0 || space == 0) {
+        if (available <= 0 && !conn.client.connected()) {
+            closeConnection(conn);
+            return;
+        }
+        bool between_requests = (conn.state == ConnectionState::ReadingHead && conn.len == 0 &&
+                                 conn.requests_served > 0);
+        if (between_requests) {
+            if (now_ms - conn.last_activity_ms >= kKeepAliveIdleMs) {
+                closeConnection(conn);
+            }
+            return;
+        }
+        if (now_ms - conn.last_activity_ms >= kRequestTimeoutMs) {
+            respond(conn.client, 400, "text/plain",
+                    (conn.state == ConnectionState::ReadingHead) ? "incomplete_header" : "incomplete_body");
+            closeConnection(conn);
+        }
         return;
     }
+
+    size_t want = (static_cast<size_t>(available) < space) ? static_cast<size_t>(available) : space;
+    int got = conn.client.read(reinterpret_cast<uint8_t*>(conn.buf + conn.len), want);
+    if (got > 0) {
+        conn.len += static_cast<size_t>(got);
+        conn.last_activity_ms = now_ms;
+    }
+    conn.buf[conn.len] = '\0';
+
+    processBufferedRequests(conn);
+}
+
+void WebConfigServer::processBufferedRequests(Connection& conn) {
+    // Loops only when a pipelining client left a complete next request in the buffer.
+    while (true) {
+        if (conn.state == ConnectionState::ReadingHead) {
+            if (!scanForHeadEnd(conn)) {
+                if (conn.len + 1 >= sizeof(conn.buf)) {
+                    respond(conn.client, 400, "text/plain", "incomplete_header");
+                    closeConnection(conn);
+                }
+                return;
+            }
+            if (!parseRequestHead(conn)) {
+                closeConnection(conn);
+                return;
+            }
+            resolveRoute(conn);
+            if (!prepareBody(conn)) {
+                closeConnection(conn);
+                return;
+            }
+            conn.state = ConnectionState::ReadingBody;
+        }
+
+        if (conn.body_streaming) {
+            if (!consumeStreamedBody(conn)) {
+                closeConnection(conn);
+                return;
+            }
+            if (conn.body_remaining > 0) {
+                return;
+            }
+        }
+        if (conn.len - conn.body_offset < conn.content_length) {
+            return;
+        }
+        size_t request_end = conn.body_offset + conn.content_length;
+        char next_byte = conn.buf[request_end];
+        conn.buf[request_end] = '\0';
+
+        if (conn.requests_served < 255) {
+            conn.requests_served += 1;
+        }
+        if (conn.keep_alive) {
+            // Always leave one slot free so idle persistent clients cannot lock out new ones.
+            conn.keep_alive = (conn.requests_served < kKeepAliveMaxRequests) &&
+                              (activeConnectionCount() < kMaxConnections);
+        }
+        response_keep_alive_ = conn.keep_alive;
+        handleRequest(conn);
+        response_keep_alive_ = false;
+
+        if (conn.state == ConnectionState::EventStream) {
+            return;
+        }
+        conn.buf[request_end] = next_byte;
+        size_t leftover = conn.len - request_end;
+        if (conn.state == ConnectionState::WebSocket) {
+            // A client may send its first frames right behind the upgrade request.
+            memmove(conn.buf, conn.buf + request_end, leftover);
+            conn.len = leftover;
+            if (leftover > 0 && !handleWebSocketFrames(conn)) {
+                closeConnection(conn);
+            }
+            return;
+        }
+        if (!conn.keep_alive) {
+            closeConnection(conn);
+            return;
+        }
+
+        memmove(conn.buf, conn.buf + request_end, leftover);
+        conn.len = leftover;
+        conn.buf[conn.len] = '\0';
+        conn.state = ConnectionState::ReadingHead;
+        conn.scan_pos = 0;
+        conn.terminator_match = 0;
+        conn.body_offset = 0;
+        conn.content_length = 0;
+        conn.body_streaming = false;
+        conn.body_remaining = 0;
+        conn.body_received = 0;
+        conn.route = kNoRoute;
+        conn.method = nullptr;
+        conn.path = nullptr;
+        conn.query = nullptr;
+        conn.if_none_match = nullptr;
+        conn.websocket_key = nullptr;
+        conn.websocket_version = nullptr;
+        conn.accepts_gzip = false;
+        conn.last_activity_ms = millis();
+        if (conn.len == 0) {
+            return;
+        }
+    }
+}
+
+uint8_t WebConfigServer::activeConnectionCount() const {
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < kMaxConnections; ++i) {
+        if (connections_[i].state != ConnectionState::Idle) {
+            count += 1;
+        }
+    }
+    return count;
+}
+
+bool WebConfigServer::scanForHeadEnd(Connection& conn) {
+    static const char kTerminator[] = "\r\n\r\n";
+    // Resume where the previous burst stopped instead of rescanning the whole buffer.
+    while (conn.scan_pos < conn.len) {
+        char c = conn.buf[conn.scan_pos++];
+        if (c == kTerminator[conn.terminator_match]) {
+            conn.terminator_match += 1;
+            if (conn.terminator_match == 4) {
+                conn.body_offset = conn.scan_pos;
+                return true;
+            }
+        } else {
+            conn.terminator_match = (c == '\r') ? 1 : 0;
+        }
+    }
+    return false;
+}
+
+bool WebConfigServer::parseRequestHead(Connection& conn) {
+    char* raw = conn.buf;
+    char* header_end = raw + conn.body_offset - 4;
+
+    char* line_end = strstr(raw, "\r\n");
+    if (line_end == nullptr || line_end > header_end) {
+        respond(conn.client, 400, "text/plain", "bad_request");
+        return false;
+    }
     *line_end = '\0';
 
     char* method = raw;
     char* sp1 = strchr(method, ' ');
     if (sp1 == nullptr) {
-        respond(client, 400, "text/plain", "bad_request_line");
-        return;
+        respond(conn.client, 400, "text/plain", "bad_request_line");
+        return false;
     }
     *sp1 = '\0';
 
     char* path = sp1 + 1;
     char* sp2 = strchr(path, ' ');
     if (sp2 == nullptr) {
-        respond(client, 400, "text/plain", "bad_request_line");
-        return;
+        respond(conn.client, 400, "text/plain", "bad_request_line");
+        return false;
     }
     *sp2 = '\0';
+    const char* version = sp2 + 1;
+    bool http11 = (strcmp(version, "HTTP/1.1") == 0);
+    bool connection_close = false;
+    bool connection_keep_alive = false;
+    const char* if_none_match = nullptr;
+    const char* websocket_key = nullptr;
+    const char* websocket_version = nullptr;
+    bool accepts_gzip = false;
+    bool upgrade_websocket = false;
 
     char* query = nullptr;
     char* query_start = strchr(path, '?');
@@ -115,164 +369,132 @@ void WebConfigServer::handleClient(TCPClient& client) {
         }
 
         *next = '\0';
-        if (header_line[0] != '\0') {
-            const char* key = "content-length:";
-            const size_t key_len = 15;
-            bool key_match = (strlen(header_line) >= key_len);
-            if (key_match) {
-                for (size_t i = 0; i < key_len; ++i) {
-                    if (tolower(static_cast<unsigned char>(header_line[i])) != key[i]) {
-                        key_match = false;
-                        break;
-                    }
-                }
+        const char* value = nullptr;
+        bool keep_terminated = false;
+        if (matchHeader(header_line, "content-length", value)) {
+            char* end_ptr = nullptr;
+            errno = 0;
+            unsigned long parsed = strtoul(value, &end_ptr, 10);
+            if (end_ptr == value || *end_ptr != '\0') {
+                respond(conn.client, 400, "text/plain", "bad_content_length");
+                return false;
             }
-            if (key_match) {
-                const char* value = header_line + key_len;
-                while (*value == ' ' || *value == '\t') {
-                    ++value;
-                }
-                char* end_ptr = nullptr;
-                unsigned long parsed = strtoul(value, &end_ptr, 10);
-                if (end_ptr == value || *end_ptr != '\0') {
-                    respond(client, 400, "text/plain", "bad_content_length");
-                    return;
-                }
-                content_length = static_cast<size_t>(parsed);
-                has_content_length = true;
+            // No route takes more than a streamed body; bounding it here also
+            // keeps the buffer arithmetic below from wrapping.
+            if (errno == ERANGE || parsed > kMaxStreamedBodyLength) {
+                respond(conn.client, 400, "text/plain", "body_too_large");
+                return false;
             }
+            content_length = static_cast<size_t>(parsed);
+            has_content_length = true;
+        } else if (matchHeader(header_line, "connection", value)) {
+            connection_close = hasTokenIgnoreCase(value, "close");
+            connection_keep_alive = hasTokenIgnoreCase(value, "keep-alive");
+        } else if (matchHeader(header_line, "accept-encoding", value)) {
+            accepts_gzip = (strstr(value, "gzip") != nullptr);
+        } else if (matchHeader(header_line, "upgrade", value)) {
+            upgrade_websocket = hasTokenIgnoreCase(value, "websocket");
+        } else if (matchHeader(header_line, "if-none-match", value)) {
+            if_none_match = value;
+            keep_terminated = true;
+        } else if (matchHeader(header_line, "sec-websocket-key", value)) {
+            websocket_key = value;
+            keep_terminated = true;
+        } else if (matchHeader(header_line, "sec-websocket-version", value)) {
+            websocket_version = value;
+            keep_terminated = true;
+        }
+        // Header values read during dispatch keep their terminator in place.
+        if (!keep_terminated) {
+            *next = '\r';
         }
-        *next = '\r';
         header_line = next + 2;
     }
 
-    size_t body_offset = static_cast<size_t>((header_end + 4) - raw);
-    size_t body_available = (raw_len > body_offset) ? (raw_len - body_offset) : 0;
+    conn.method = method;
+    conn.path = path;
+    conn.query = query;
+    conn.keep_alive = http11 ? !connection_close : connection_keep_alive;
+    conn.if_none_match = if_none_match;
+    conn.websocket_key = upgrade_websocket ? websocket_key : nullptr;
+    conn.websocket_version = upgrade_websocket ? websocket_version : nullptr;
+    conn.accepts_gzip = accepts_gzip;
+    conn.content_length = (strcmp(method, "POST") == 0 && has_content_length) ? content_length : 0;
+    return true;
+}
 
-    if (strcmp(method, "POST") == 0 && has_content_length) {
-        if (body_offset + content_length + 1 > sizeof(raw)) {
-            respond(client, 400, "text/plain", "body_too_large");
-            return;
+// Decides, once the route is known, whether the body is buffered whole or streamed.
+bool WebConfigServer::prepareBody(Connection& conn) {
+    bool streamed = conn.route != kNoRoute && kRouteHandlers[conn.route].body != nullptr &&
+                    strcmp(conn.method, "POST") == 0;
+    if (streamed) {
+        if (conn.content_length > kMaxStreamedBodyLength) {
+            respond(conn.client, 400, "text/plain", "body_too_large");
+            return false;
         }
-        while (body_available < content_length && millis() - start < kReadTimeoutMs && raw_len + 1 < sizeof(raw)) {
-            while (client.available() && raw_len + 1 < sizeof(raw) && body_available < content_length) {
-                raw[raw_len++] = static_cast<char>(client.read());
-                body_available++;
-            }
-            raw[raw_len] = '\0';
-        }
-        if (body_available < content_length) {
-            respond(client, 400, "text/plain", "incomplete_body");
-            return;
-        }
-        raw[body_offset + content_length] = '\0';
-    }
-
-    const char* body = raw + body_offset;
-    const char* form = (body[0] != '\0') ? body : ((query != nullptr) ? query : "");
-
-    if (strcmp(method, "GET") == 0 && strcmp(path, "/api/v2/settings") == 0) {
-        handleApiSettingsGet(client);
-        return;
-    }
-    if (strcmp(method, "GET") == 0 && strcmp(path, "/api/v2/state") == 0) {
-        handleApiStateGet(client);
-        return;
+        conn.body_streaming = true;
+        conn.body_remaining = conn.content_length;
+        conn.content_length = 0;
+        return true;
     }
-    if (strcmp(method, "POST") == 0 && strcmp(path, "/api/v2/settings") == 0) {
-        handleApiSettingsPost(client, form);
-        return;
-    }
-    if (strcmp(method, "POST") == 0 && strcmp(path, "/api/v2/control") == 0) {
-        handleApiControlPost(client, form);
-        return;
-    }
-    if (strcmp(method, "POST") == 0 && strcmp(path, "/api/v2/system/reboot") == 0) {
-        handleApiSystemReboot(client);
-        return;
-    }
-    if (strcmp(method, "POST") == 0 && strcmp(path, "/api/v2/system/dfu") == 0) {
-        handleApiSystemDfu(client);
-        return;
-    }
-    if (strcmp(method, "GET") == 0 && (strcmp(path, "/") == 0 || strcmp(path, "/index.html") == 0)) {
-        respond(client, 200, "text/html", webUiIndexHtml());
-        return;
+    if (conn.content_length > sizeof(conn.buf) - 1 - conn.body_offset) {
+        respond(conn.client, 400, "text/plain", "body_too_large");
+        return false;
     }
-
-    respond(client, 404, "text/plain", "not_found");
+    return true;
 }
 
-size_t WebConfigServer::urlDecode(const char* src, size_t src_len, char* dst, size_t dst_size) const {
-    if (dst_size == 0) {
-        return 0;
-    }
-
-    size_t out = 0;
-    for (size_t i = 0; i < src_len && out + 1 < dst_size; ++i) {
-        char c = src[i];
-        if (c == '+') {
-            dst[out++] = ' ';
-        } else if (c == '%' && i + 2 < src_len) {
-            int hi = hexToInt(src[i + 1]);
-            int lo = hexToInt(src[i + 2]);
-            if (hi >= 0 && lo >= 0) {
-                dst[out++] = static_cast<char>((hi << 4) | lo);
-                i += 2;
-            } else {
-                dst[out++] = c;
-            }
-        } else {
-            dst[out++] = c;
-        }
+// Hands whatever part of the body has arrived to the route's body handler and
+// drops it from the buffer, so a body can be larger than the buffer.
+bool WebConfigServer::consumeStreamedBody(Connection& conn) {
+    size_t available = conn.len - conn.body_offset;
+    size_t chunk = (available < conn.body_remaining) ? available : conn.body_remaining;
+    if (chunk == 0) {
+        return true;
     }
-    dst[out] = '\0';
-    return out;
-}
 
-bool WebConfigServer::getParam(const char* data, const char* key, char* out, size_t out_size) const {
-    if (data == nullptr || key == nullptr || out == nullptr || out_size == 0) {
+    char* data = conn.buf + conn.body_offset;
+    BodyHandler handler = kRouteHandlers[conn.route].body;
+    if (!(this->*handler)(conn, data, chunk)) {
         return false;
     }
 
-    out[0] = '\0';
-    size_t key_len = strlen(key);
-    const char* p = data;
-    while (*p != '\0') {
-        while (*p == '&' || *p == '?' || *p == ' ') {
-            ++p;
-        }
-        if (*p == '\0') {
-            break;
-        }
+    memmove(data, data + chunk, available - chunk);
+    conn.len -= chunk;
+    conn.buf[conn.len] = '\0';
+    conn.body_remaining -= chunk;
+    conn.body_received += chunk;
+    return true;
+}
 
-        if (strncmp(p, key, key_len) == 0 && p[key_len] == '=') {
-            const char* value = p + key_len + 1;
-            const char* end = value;
-            while (*end != '\0' && *end != '&' && *end != ' ') {
-                ++end;
-            }
-            urlDecode(value, static_cast<size_t>(end - value), out, out_size);
-            return true;
-        }
+void WebConfigServer::handleIndexGet(Connection& conn) {
+    const bool gzip = conn.accepts_gzip;
+    const char* etag = webUiIndexHtmlEtag(gzip);
 
-        const char* next_amp = strchr(p, '&');
-        const char* next_q = strchr(p, '?');
-        const char* next = nullptr;
-        if (next_amp == nullptr) {
-            next = next_q;
-        } else if (next_q == nullptr) {
-            next = next_amp;
-        } else {
-            next = (next_amp < next_q) ? next_amp : next_q;
-        }
-        if (next == nullptr) {
-            break;
-        }
-        p = next + 1;
+    char headers[128];
+    // no-cache still lets the browser keep the page, it just revalidates with If-None-Match.
+    snprintf(headers,
+             sizeof(headers),
+             "ETag: %s\r\nCache-Control: no-cache\r\nVary: Accept-Encoding\r\n%s",
+             etag,
+             gzip ? "Content-Encoding: gzip\r\n" : "");
+
+    if (conn.if_none_match != nullptr &&
+        (strstr(conn.if_none_match, etag) != nullptr || strcmp(conn.if_none_match, "*") == 0)) {
+        respondN(conn.client, 304, "text/html", nullptr, 0, headers);
+        return;
     }
 
-    return false;
+    if (gzip) {
+        respondN(conn.client,
+                 200,
+                 "text/html",
+                 reinterpret_cast<const char*>(webUiIndexHtmlGzip()),
+                 webUiIndexHtmlGzipLength(),
+                 headers);
+        return;
+    }
+    respondN(conn.client, 200, "text/html", webUiIndexHtml(), webUiIndexHtmlLength(), headers);
 }
 
 void WebConfigServer::respond(TCPClient& client, int status, const char* content_type, const char* body) {
@@ -284,14 +506,56 @@ void WebConfigServer::respondN(TCPClient& client,
                                int status,
                                const char* content_type,
                                const char* body,
-                               size_t body_len) {
-    client.printlnf("HTTP/1.1 %d %s", status, statusReason(status));
-    client.printlnf("Content-Type: %s", content_type);
-    client.printlnf("Content-Length: %u", static_cast<unsigned>(body_len));
-    client.println("Connection: close");
-    client.println();
-
+                               size_t body_len,
+                               const char* extra_headers) {
+    writeResponseHead(client, status, content_type, body_len, extra_headers);
     if (body_len > 0 && body != nullptr) {
-        client.write(reinterpret_cast<const uint8_t*>(body), body_len);
+        response_.write(body, body_len);
+    }
+    finishResponse();
+}
+
+// Starts a buffered response; the caller streams the body into response_ and
+// then calls finishResponse().
+void WebConfigServer::writeResponseHead(TCPClient& client,
+                                        int status,
+                                        const char* content_type,
+                                        size_t body_len,
+                                        const char* extra_headers) {
+    response_.begin(client);
+    response_.printf("HTTP/1.1 %d %s\r\n", status, statusReason(status));
+    if (status != 304 && content_type != nullptr) {
+        response_.printf("Content-Type: %s\r\n", content_type);
+        if (body_len != kStreamBody) {
+            response_.printf("Content-Length: %u\r\n", static_cast<unsigned>(body_len));
+        }
+    }
+    if (extra_headers != nullptr) {
+        response_.print(extra_headers);
+    }
+    // A stream owns the connection from here on; its extra_headers say how.
+    if (body_len != kStreamBody) {
+        if (response_keep_alive_) {
+            response_.printf("Connection: keep-alive\r\nKeep-Alive: timeout=%u, max=%u\r\n",
+                             static_cast<unsigned>(kKeepAliveIdleMs / 1000),
+                             static_cast<unsigned>(kKeepAliveMaxRequests));
+        } else {
+            response_.print("Connection: close\r\n");
+        }
+    }
+    response_.print("\r\n");
+}
+
+void WebConfigServer::finishResponse() {
+    response_.end();
+    if (state_ == nullptr) {
+        return;
     }
+    MetricsRegistry& metrics = state_->metrics;
+    metrics.add(MetricId::HttpResponses);
+    metrics.add(MetricId::HttpResponseBytes, response_.bytes());
+    metrics.add(MetricId::HttpResponseSegments, response_.segments());
+    metrics.set(MetricId::HttpLastResponseBytes, response_.bytes());
+    metrics.set(MetricId::HttpLastResponseSegments, response_.segments());
+    metrics.observe(HistogramId::HttpResponseBytes, response_.bytes());
 }
@@ -0,0 +1,141 @@
+#include "web_config_server.h"
+
+#include "../util/const_hash.h"
+
+#include <string.h>
+
+namespace {
+enum RouteId : uint8_t {
+    kRouteRoot = 0,
+    kRouteIndexHtml,
+    kRouteSettings,
+    kRouteState,
+    kRouteStateBin,
+    kRouteHistoryBin,
+    kRouteEvents,
+    kRouteWebSocket,
+    kRouteControl,
+    kRouteControlBatch,
+    kRouteSystemReboot,
+    kRouteSystemDfu,
+    kRouteMetrics,
+    kRouteCount,
+};
+
+// Paths in RouteId order. The lookup switch below is generated from these
+// strings at compile time, so the two cannot drift apart.
+constexpr const char* kRoutePaths[] = {
+    "/",
+    "/index.html",
+    "/api/v2/settings",
+    "/api/v2/state",
+    "/api/v2/state.bin",
+    "/api/v2/history.bin",
+    "/api/v2/events",
+    "/api/v2/ws",
+    "/api/v2/control",
+    "/api/v2/control/batch",
+    "/api/v2/system/reboot",
+    "/api/v2/system/dfu",
+    "/metrics",
+};
+static_assert(sizeof(kRoutePaths) / sizeof(kRoutePaths[0]) == kRouteCount, "route path table out of sync");
+
+// One hash of the path and one compare, whatever the number of routes. Case
+// labels are compile-time hashes, so two colliding paths fail the build.
+#define ROUTE_CASE(id)                 \
+    case constHash(kRoutePaths[id]):   \
+        return spanEquals(path, len, kRoutePaths[id]) ? (id) : kRouteCount
+
+uint8_t findRoute(const char* path) {
+    size_t len = strlen(path);
+    switch (hashSpan(path, len)) {
+        ROUTE_CASE(kRouteRoot);
+        ROUTE_CASE(kRouteIndexHtml);
+        ROUTE_CASE(kRouteSettings);
+        ROUTE_CASE(kRouteState);
+        ROUTE_CASE(kRouteStateBin);
+        ROUTE_CASE(kRouteHistoryBin);
+        ROUTE_CASE(kRouteEvents);
+        ROUTE_CASE(kRouteWebSocket);
+        ROUTE_CASE(kRouteControl);
+        ROUTE_CASE(kRouteControlBatch);
+        ROUTE_CASE(kRouteSystemReboot);
+        ROUTE_CASE(kRouteSystemDfu);
+        ROUTE_CASE(kRouteMetrics);
+        default:
+            return kRouteCount;
+    }
+}
+
+#undef ROUTE_CASE
+}  // namespace
+
+const WebConfigServer::RouteHandlers WebConfigServer::kRouteHandlers[] = {
+    // GET, POST, streamed POST body
+    {&WebConfigServer::handleIndexGet, nullptr, nullptr},
+    {&WebConfigServer::handleIndexGet, nullptr, nullptr},
+    {&WebConfigServer::handleApiSettingsGet,
+     &WebConfigServer::handleApiSettingsPost,
+     &WebConfigServer::handleApiSettingsBody},
+    {&WebConfigServer::handleApiStateGet, nullptr, nullptr},
+    {&WebConfigServer::handleApiStateBinGet, nullptr, nullptr},
+    {&WebConfigServer::handleApiHistoryBinGet, nullptr, nullptr},
+    {&WebConfigServer::handleApiEventsGet, nullptr, nullptr},
+    {&WebConfigServer::handleApiWebSocketGet, nullptr, nullptr},
+    {nullptr, &WebConfigServer::handleApiControlPost, nullptr},
+    {nullptr, &WebConfigServer::handleApiControlBatchPost, nullptr},
+    {nullptr, &WebConfigServer::handleApiSystemReboot, nullptr},
+    {nullptr, &WebConfigServer::handleApiSystemDfu, nullptr},
+    {&WebConfigServer::handleMetricsGet, nullptr, nullptr},
+};
+
+void WebConfigServer::resolveRoute(Connection& conn) {
+    static_assert(sizeof(kRouteHandlers) / sizeof(kRouteHandlers[0]) == kRouteCount, "route handler table out of sync");
+    static_assert(kRouteCount < kNoRoute, "route ids must stay below kNoRoute");
+
+    uint8_t route = findRoute(conn.path);
+    conn.route = (route == kRouteCount) ? kNoRoute : route;
+}
+
+void WebConfigServer::handleRequest(Connection& conn) {
+    if (conn.route == kNoRoute) {
+        respond(conn.client, 404, "text/plain", "not_found");
+        return;
+    }
+
+    const RouteHandlers& handlers = kRouteHandlers[conn.route];
+    RouteHandler handler = nullptr;
+    if (strcmp(conn.method, "GET") == 0) {
+        handler = handlers.get;
+    } else if (strcmp(conn.method, "POST") == 0) {
+        handler = handlers.post;
+    }
+
+    if (handler == nullptr) {
+        respondMethodNotAllowed(conn, handlers);
+        return;
+    }
+    (this->*handler)(conn);
+}
+
+void WebConfigServer::respondMethodNotAllowed(Connection& conn, const RouteHandlers& handlers) {
+    const char* allow = "Allow: GET\r\n";
+    if (handlers.get != nullptr && handlers.post != nullptr) {
+        allow = "Allow: GET, POST\r\n";
+    } else if (handlers.post != nullptr) {
+        allow = "Allow: POST\r\n";
+    }
+    static const char kBody[] = "method_not_allowed";
+    respondN(conn.client, 405, "text/plain", kBody, sizeof(kBody) - 1, allow);
+}
+
+// Form fields come from the body when there is one, otherwise from the query
+// string. The body region is always NUL-terminated, so it doubles as "".
+char* WebConfigServer::requestForm(Connection& conn) {
+    char* body = conn.buf + conn.body_offset;
+    if (body[0] == '\0' && conn.query != nullptr) {
+        return conn.query;
+    }
+    return body;
+}
@@ -0,0 +1,208 @@
+#include "web_config_server.h"
+
+#include "../util/base64.h"
+#include "../util/sha1.h"
+
+#include <stdio.h>
+#include <string.h>
+
+namespace {
+const char kWebSocketGuid[] = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+const uint32_t kWebSocketPingMs = 15000;
+// Browsers answer pings on their own, so a peer silent for two ping periods
+// is gone (half-open) and its stream slot is reclaimed.
+const uint32_t kWebSocketIdleMs = 2 * kWebSocketPingMs;
+// Control messages are short form strings; anything longer is rejected outright.
+const size_t kWebSocketMaxPayload = 125;
+
+const uint8_t kOpText = 0x1;
+const uint8_t kOpBinary = 0x2;
+const uint8_t kOpClose = 0x8;
+const uint8_t kOpPing = 0x9;
+const uint8_t kOpPong = 0xA;
+}  // namespace
+
+void WebConfigServer::handleApiWebSocketGet(Connection& conn) {
+    if (conn.websocket_key == nullptr || conn.websocket_key[0] == '\0') {
+        respond(conn.client, 400, "text/plain", "websocket_upgrade_required");
+        return;
+    }
+    // RFC 6455 is version 13; anything else is told which version we speak.
+    if (conn.websocket_version == nullptr || strcmp(conn.websocket_version, "13") != 0) {
+        static const char kBody[] = "websocket_version_unsupported";
+        respondN(conn.client, 426, "text/plain", kBody, sizeof(kBody) - 1, "Sec-WebSocket-Version: 13\r\n");
+        return;
+    }
+    if (!reserveStreamSlot(conn)) {
+        return;
+    }
+
+    Sha1Context sha;
+    uint8_t digest[SHA1_DIGEST_SIZE];
+    sha1_init(sha);
+    sha1_update(sha, reinterpret_cast<const uint8_t*>(conn.websocket_key), strlen(conn.websocket_key));
+    sha1_update(sha, reinterpret_cast<const uint8_t*>(kWebSocketGuid), sizeof(kWebSocketGuid) - 1);
+    sha1_final(sha, digest);
+
+    char accept[32];
+    base64Encode(digest, sizeof(digest), accept, sizeof(accept));
+
+    char headers[96];
+    snprintf(headers,
+             sizeof(headers),
+             "Upgrade: websocket\r\nConnection: Upgrade\r\nSec-WebSocket-Accept: %s\r\n",
+             accept);
+    writeResponseHead(conn.client, 101, nullptr, kStreamBody, headers);
+    finishResponse();
+    // Frames pipelined behind the upgrade request stay in conn.buf; the request
+    // loop moves them to the front once this handler returns.
+    conn.state = ConnectionState::WebSocket;
+    conn.last_activity_ms = millis();
+    conn.last_rx_ms = conn.last_activity_ms;
+    conn.last_ping_ms = conn.last_activity_ms;
+    pushStateEvent(conn, true);
+}
+
+void WebConfigServer::serviceWebSocket(Connection& conn, uint32_t now_ms) {
+    if (!conn.client.connected()) {
+        closeConnection(conn);
+        return;
+    }
+
+    int available = conn.client.available();
+    if (available > 0) {
+        size_t space = sizeof(conn.buf) - 1 - conn.len;
+        size_t want = (static_cast<size_t>(available) < space) ? static_cast<size_t>(available) : space;
+        int got = conn.client.read(reinterpret_cast<uint8_t*>(conn.buf + conn.len), want);
+        if (got > 0) {
+            conn.len += static_cast<size_t>(got);
+        }
+        if (!handleWebSocketFrames(conn)) {
+            closeConnection(conn);
+            return;
+        }
+    }
+
+    if (state_changed_ && !pushStateEvent(conn, false)) {
+        closeConnection(conn);
+        return;
+    }
+
+    if (now_ms - conn.last_rx_ms >= kWebSocketIdleMs) {
+        sendWebSocketFrame(conn, kOpClose, "\x03\xE9", 2);  // 1001 going away
+        closeConnection(conn);
+        return;
+    }
+    // Pings run on their own period: state pushes keep the socket busy but
+    // do not make the peer answer.
+    if (now_ms - conn.last_ping_ms >= kWebSocketPingMs) {
+        conn.last_ping_ms = now_ms;
+        conn.last_activity_ms = now_ms;
+        if (!sendWebSocketFrame(conn, kOpPing, nullptr, 0)) {
+            closeConnection(conn);
+        }
+    }
+}
+
+bool WebConfigServer::handleWebSocketFrames(Connection& conn) {
+    uint8_t* buf = reinterpret_cast<uint8_t*>(conn.buf);
+    while (conn.len >= 2) {
+        bool fin = (buf[0] & 0x80) != 0;
+        uint8_t opcode = buf[0] & 0x0F;
+        bool masked = (buf[1] & 0x80) != 0;
+        size_t payload_len = buf[1] & 0x7F;
+
+        // Clients must mask, and nothing they are allowed to send needs fragments,
+        // extensions (RSV bits) or long lengths.
+        if (!fin || !masked || (buf[0] & 0x70) != 0) {
+            sendWebSocketFrame(conn, kOpClose, "\x03\xEA", 2);  // 1002 protocol error
+            return false;
+        }
+        if (payload_len > kWebSocketMaxPayload) {
+            sendWebSocketFrame(conn, kOpClose, "\x03\xF1", 2);  // 1009 message too big
+            return false;
+        }
+        size_t frame_len = 2 + 4 + payload_len;
+        if (conn.len < frame_len) {
+            return true;
+        }
+
+        // Any complete frame, pongs included, shows the peer is still there.
+        conn.last_rx_ms = millis();
+
+        const uint8_t* mask = buf + 2;
+        char* payload = conn.buf + 6;
+        for (size_t i = 0; i < payload_len; ++i) {
+            payload[i] = static_cast<char>(payload[i] ^ mask[i & 3]);
+        }
+
+        if (opcode == kOpClose) {
+            sendWebSocketFrame(conn, kOpClose, payload, payload_len >= 2 ? 2 : 0);
+            return false;
+        }
+        if (opcode == kOpBinary) {
+            sendWebSocketFrame(conn, kOpClose, "\x03\xEB", 2);  // 1003 unsupported data
+            return false;
+        }
+        if (opcode == kOpPing) {
+            sendWebSocketFrame(conn, kOpPong, payload, payload_len);
+        } else if (opcode == kOpText) {
+            char saved = payload[payload_len];
+            payload[payload_len] = '\0';
+            handleWebSocketText(conn, payload);
+            payload[payload_len] = saved;
+        } else if (opcode != kOpPong) {
+            // Continuation without a start, or a reserved opcode.
+            sendWebSocketFrame(conn, kOpClose, "\x03\xEA", 2);  // 1002 protocol error
+            return false;
+        }
+
+        memmove(conn.buf, conn.buf + frame_len, conn.len - frame_len);
+        conn.len -= frame_len;
+    }
+    return true;
+}
+
+void WebConfigServer::handleWebSocketText(Connection& conn, char* text) {
+    char errors[64] = {0};
+    Command commands[3];
+    size_t command_count = 0;
+
+    ControlParseResult parsed = parseControlCommands(text, commands, command_count, errors, sizeof(errors));
+    char reply[96];
+    if (parsed == ControlParseResult::MissingFields) {
+        snprintf(reply, sizeof(reply), "{\"ok\":false,\"error\":\"missing_control_fields\"}");
+    } else if (parsed == ControlParseResult::Invalid) {
+        snprintf(reply, sizeof(reply), "{\"ok\":false,\"error\":\"validation_failed\",\"fields\":\"%s\"}", errors);
+    } else {
+        const char* error = submitCommands(commands, command_count);
+        if (error == nullptr) {
+            snprintf(reply, sizeof(reply), "{\"ok\":true}");
+        } else {
+            snprintf(reply, sizeof(reply), "{\"ok\":false,\"error\":\"%s\"}", error);
+        }
+    }
+    sendWebSocketFrame(conn, kOpText, reply, strlen(reply));
+}
+
+bool WebConfigServer::sendWebSocketFrame(Connection& conn, uint8_t opcode, const char* payload, size_t len) {
+    uint8_t header[4];
+    size_t header_len = 2;
+    header[0] = static_cast<uint8_t>(0x80 | opcode);
+    if (len <= 125) {
+        header[1] = static_cast<uint8_t>(len);
+    } else if (len <= 0xFFFF) {
+        header[1] = 126;
+        header[2] = static_cast<uint8_t>(len >> 8);
+        header[3] = static_cast<uint8_t>(len);
+        header_len = 4;
+    } else {
+        return false;
+    }
+
+    // Header and payload share one segment rather than going out as two writes.
+    response_.begin(conn.client);
+    response_.write(reinterpret_cast<const char*>(header), header_len);
+    response_.write(payload, len);
+    return response_.end();
+}
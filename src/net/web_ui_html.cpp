@@ -1,3 +1,4 @@
+// Generated by tools/gen_web_ui.py from web/index.html. Do not edit.
 #include "web_ui_html.h"
 
 namespace {
@@ -414,6 +415,7 @@ body[data-theme="dark"] button.action {
                 <div class="row"><label>MQTT User</label><input id="mqtt-user" type="text" autocomplete="off"></div>
                 <div class="row"><label>MQTT Pass</label><input id="mqtt-pass" type="password" autocomplete="off" placeholder="leave blank to keep"></div>
                 <div class="row"><label>MQTT Topic Root</label><input id="mqtt-topic-root" type="text" autocomplete="off"></div>
+                <div class="row"><label>MQTT Aggregate</label><input id="mqtt-aggregate" type="checkbox"></div>
                 <div class="row"><label>Device ID</label><input id="device-id" type="text" autocomplete="off"></div>
                 <div class="btn-row">
                     <button class="primary" type="submit">Save Settings</button>
@@ -451,6 +453,8 @@ body[data-theme="dark"] button.action {
         mqtt_connected: false
     };
     var toastTimer = null;
+    var pollTimer = null;
+    var socket = null;
     var isFanDragging = false;
     var fanDebounceTimer = null;
     var themeKey = 'aeris_ui_theme';
@@ -598,6 +602,88 @@ body[data-theme="dark"] button.action {
         }
     }
 
+    function mergeState(delta) {
+        var merged = {};
+        Object.keys(stateCache).forEach(function (key) {
+            merged[key] = stateCache[key];
+        });
+        Object.keys(delta).forEach(function (key) {
+            merged[key] = delta[key];
+        });
+        renderState(merged);
+    }
+
+    function startPolling() {
+        if (!pollTimer) {
+            pollTimer = setInterval(loadState, 2000);
+        }
+    }
+
+    function stopPolling() {
+        if (pollTimer) {
+            clearInterval(pollTimer);
+            pollTimer = null;
+        }
+    }
+
+    function startEventStream() {
+        if (!window.EventSource) {
+            startPolling();
+            return;
+        }
+        var source = new EventSource('/api/v2/events');
+        source.onopen = function () {
+            stopPolling();
+        };
+        source.onmessage = function (evt) {
+            try {
+                mergeState(JSON.parse(evt.data));
+            } catch (err) {
+            }
+        };
+        source.onerror = function () {
+            startPolling();
+        };
+    }
+
+    function startLiveUpdates() {
+        if (!window.WebSocket) {
+            startEventStream();
+            return;
+        }
+        var opened = false;
+        var ws = new WebSocket('ws://' + location.host + '/api/v2/ws');
+        ws.onopen = function () {
+            opened = true;
+            socket = ws;
+            stopPolling();
+        };
+        ws.onmessage = function (evt) {
+            var msg;
+            try {
+                msg = JSON.parse(evt.data);
+            } catch (err) {
+                return;
+            }
+            if (Object.prototype.hasOwnProperty.call(msg, 'ok')) {
+                if (!msg.ok) {
+                    showToast('Control failed: ' + msg.error);
+                }
+                return;
+            }
+            mergeState(msg);
+        };
+        ws.onclose = function () {
+            socket = null;
+            if (opened) {
+                startPolling();
+                setTimeout(startLiveUpdates, 3000);
+            } else {
+                startEventStream();
+            }
+        };
+    }
+
     async function loadSettings() {
         try {
             var s = await apiGet('/api/v2/settings');
@@ -608,14 +694,21 @@ body[data-theme="dark"] button.action {
             byId('mqtt-user').value = s.mqtt_user || '';
             byId('device-id').value = s.device_id || '';
             byId('mqtt-topic-root').value = s.mqtt_topic_root || '';
+            byId('mqtt-aggregate').checked = Number(s.mqtt_publish_mode || 0) === 1;
         } catch (err) {
             showToast('Settings fetch failed');
         }
     }
 
     async function sendControl(payload) {
+        if (socket && socket.readyState === 1) {
+            socket.send(encodeForm(payload));
+            return;
+        }
         await apiPost('/api/v2/control', payload);
-        loadState();
+        if (pollTimer) {
+            loadState();
+        }
     }
 
     byId('settings-form').addEventListener('submit', async function (evt) {
@@ -628,7 +721,8 @@ body[data-theme="dark"] button.action {
                 mqtt_port: byId('mqtt-port').value.trim(),
                 mqtt_user: byId('mqtt-user').value.trim(),
                 device_id: byId('device-id').value.trim(),
-                mqtt_topic_root: byId('mqtt-topic-root').value.trim()
+                mqtt_topic_root: byId('mqtt-topic-root').value.trim(),
+                mqtt_publish_mode: byId('mqtt-aggregate').checked ? 1 : 0
             };
             var wifiPass = byId('wifi-pass').value;
             var mqttPass = byId('mqtt-pass').value;
@@ -651,13 +745,15 @@ body[data-theme="dark"] button.action {
         if (fanDebounceTimer) {
             clearTimeout(fanDebounceTimer);
         }
+        // Over the socket a send is one small frame, so track the slider much more closely.
+        var delayMs = (socket && socket.readyState === 1) ? 40 : 160;
         fanDebounceTimer = setTimeout(async function () {
             try {
                 await sendControl({ fan_percent: value });
             } catch (err) {
                 showToast('Fan update failed');
             }
-        }, 160);
+        }, delayMs);
     }
 
     var fanSlider = byId('fan-slider');
@@ -734,13 +830,409 @@ body[data-theme="dark"] button.action {
     applyTheme(resolveInitialTheme());
     loadSettings();
     loadState();
-    setInterval(loadState, 2000);
+    startLiveUpdates();
 })();
 </script>
 </body>
-</html>)HTML";
+</html>
+)HTML";
+
+const uint8_t kIndexHtmlGzip[] = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xc5, 0x3c, 0xfd, 0x77, 0xdb, 0x36,
+    0x92, 0xbf, 0xe7, 0xaf, 0x40, 0xd5, 0xd7, 0x4a, 0xba, 0x15, 0x65, 0x51, 0xb2, 0x64, 0x59, 0xfe,
+    0xe8, 0x65, 0x9b, 0x66, 0xdb, 0xbb, 0xa6, 0xf1, 0xae, 0xd3, 0xb7, 0x77, 0xaf, 0xaf, 0xcf, 0x0f,
+    0x22, 0x41, 0x89, 0x35, 0x45, 0x2a, 0x24, 0x65, 0x47, 0xcd, 0xfa, 0x7f, 0xbf, 0x19, 0x00, 0x24,
+    0x01, 0x10, 0xa4, 0x14, 0xb7, 0xd9, 0xcb, 0x6b, 0x63, 0x19, 0x1f, 0x33, 0x83, 0xf9, 0x9e, 0x01,
+    0x94, 0xcb, 0x2f, 0xfc, 0xc4, 0xcb, 0xf7, 0x5b, 0x46, 0xd6, 0xf9, 0x26, 0xba, 0x7e, 0x71, 0x89,
+    0x3f, 0x48, 0x44, 0xe3, 0xd5, 0x55, 0x87, 0xc5, 0x1d, 0x1c, 0x60, 0xd4, 0x87, 0x1f, 0x1b, 0x96,
+    0x53, 0xe2, 0xad, 0x69, 0x9a, 0xb1, 0xfc, 0xaa, 0xb3, 0xcb, 0x03, 0x67, 0xde, 0x29, 0x86, 0x63,
+    0xba, 0x61, 0x57, 0x9d, 0x87, 0x90, 0x3d, 0x6e, 0x93, 0x34, 0xef, 0x10, 0x2f, 0x89, 0x73, 0x16,
+    0xc3, 0xb2, 0xc7, 0xd0, 0xcf, 0xd7, 0x57, 0x3e, 0x7b, 0x08, 0x3d, 0xe6, 0xf0, 0x5f, 0x06, 0x24,
+    0x8c, 0xc3, 0x3c, 0xa4, 0x91, 0x93, 0x79, 0x34, 0x62, 0x57, 0x2e, 0x02, 0xc9, 0xc3, 0x3c, 0x62,
+    0xd7, 0x2f, 0x59, 0x1a, 0x66, 0xe4, 0xfb, 0x64, 0xc3, 0x2e, 0x4f, 0xc4, 0xc8, 0x8b, 0xcb, 0x2c,
+    0xdf, 0xe3, 0xcf, 0x45, 0x9a, 0x24, 0x39, 0xf9, 0xf8, 0x82, 0xc0, 0x1f, 0xc7, 0x59, 0xae, 0x1c,
+    0xba, 0x20, 0x5f, 0x32, 0x3f, 0x38, 0x0d, 0x82, 0x8b, 0x6a, 0x70, 0x09, 0x83, 0xc1, 0x59, 0x30,
+    0x61, 0xcb, 0x62, 0xd0, 0xa3, 0xa9, 0x0f, 0x33, 0x0b, 0x92, 0xae, 0x96, 0xb4, 0x37, 0x9e, 0x4e,
+    0x07, 0xa4, 0xfa, 0x6b, 0x34, 0x9c, 0xcd, 0xfb, 0xfa, 0xca, 0x24, 0xf5, 0x59, 0xda, 0xb4, 0xfa,
+    0xbc, 0x5c, 0xbc, 0xdd, 0xb4, 0x01, 0x1d, 0x6b, 0xeb, 0x5a, 0x41, 0xce, 0x4f, 0x2b, 0x02, 0xd6,
+    0xe1, 0xb6, 0x05, 0xea, 0x74, 0x6a, 0xac, 0x3c, 0x92, 0xd4, 0x30, 0xde, 0xee, 0xf2, 0x16, 0xb8,
+    0x67, 0x73, 0x73, 0x69, 0x3b, 0xe0, 0x8a, 0x8c, 0xe5, 0x2e, 0xcf, 0x93, 0xb8, 0x05, 0xf4, 0x7c,
+    0x6e, 0xae, 0x0d, 0x60, 0xed, 0x97, 0xee, 0xd9, 0x64, 0x3c, 0x9d, 0x17, 0x33, 0x39, 0xfb, 0x90,
+    0xe3, 0xa0, 0x3f, 0x9e, 0x4d, 0x66, 0xc5, 0xe0, 0x66, 0x97, 0x33, 0x1f, 0x46, 0x67, 0xe3, 0xb3,
+    0xc9, 0xdc, 0x2f, 0x46, 0xa9, 0xe7, 0x81, 0x52, 0xc1, 0xf0, 0x98, 0x9d, 0x2d, 0x83, 0x53, 0x7d,
+    0xd8, 0xc9, 0x92, 0x00, 0xe7, 0x7c, 0x1f, 0xd4, 0xa2, 0x54, 0x8a, 0x55, 0x92, 0x20, 0x1c, 0x37,
+    0x38, 0x0f, 0x66, 0x67, 0x25, 0xf4, 0x10, 0xc7, 0xfc, 0xf9, 0x39, 0x9d, 0xb8, 0x25, 0x81, 0x14,
+    0xc7, 0x3c, 0xf7, 0x94, 0x9e, 0x52, 0x4d, 0x25, 0xb2, 0x35, 0xf5, 0x93, 0xc7, 0x05, 0x19, 0x11,
+    0x77, 0xbc, 0xfd, 0x40, 0x26, 0x23, 0xf8, 0x4b, 0x1c, 0x77, 0x0c, 0x07, 0x3d, 0x1f, 0x90, 0x53,
+    0x7e, 0xd6, 0x51, 0x75, 0xd6, 0x3c, 0xa1, 0x99, 0xc2, 0x71, 0xf7, 0x6c, 0x40, 0x26, 0xee, 0x80,
+    0x4c, 0xc7, 0x9c, 0x7f, 0x63, 0x63, 0x1d, 0x67, 0x49, 0xc0, 0xff, 0x5c, 0xbc, 0x78, 0x7a, 0xb1,
+    0x4c, 0xfc, 0xfd, 0x2f, 0x3e, 0xcd, 0xa9, 0x93, 0xaf, 0x19, 0x1a, 0x95, 0x4f, 0xd3, 0xfb, 0xce,
+    0xaf, 0xa6, 0xea, 0x8f, 0x02, 0x77, 0x36, 0x9e, 0x19, 0xaa, 0xef, 0x52, 0xe0, 0x61, 0x83, 0xea,
+    0xbb, 0x13, 0xa0, 0x16, 0xa8, 0x98, 0x08, 0xa1, 0x8f, 0x5b, 0xf4, 0xde, 0x1d, 0x03, 0xc5, 0xee,
+    0x74, 0x04, 0x7f, 0xcd, 0x39, 0xcd, 0x93, 0xb9, 0x55, 0xf1, 0xdd, 0x19, 0x80, 0x84, 0xa5, 0xa7,
+    0xa7, 0x5c, 0xeb, 0x67, 0x8d, 0x5a, 0x5f, 0x07, 0x38, 0x6e, 0xd2, 0x7a, 0xa4, 0x10, 0xc0, 0x4d,
+    0x27, 0x26, 0x95, 0x35, 0x95, 0x6f, 0xa3, 0xd2, 0xd0, 0x79, 0x97, 0xab, 0x24, 0x10, 0xea, 0x72,
+    0xad, 0x6c, 0xd3, 0xf7, 0x1a, 0xd4, 0xd3, 0xd3, 0x46, 0x7d, 0xe7, 0xe7, 0x9f, 0x17, 0x0a, 0x70,
+    0x6e, 0xd5, 0x75, 0xdf, 0x63, 0xe7, 0x95, 0x36, 0x4a, 0x5d, 0xd7, 0xfd, 0x56, 0xa1, 0xeb, 0x74,
+    0xb6, 0x9c, 0xfb, 0x67, 0x35, 0x5d, 0x9f, 0x8f, 0x69, 0x50, 0x2d, 0xd6, 0x74, 0x5d, 0x0a, 0x16,
+    0x89, 0x3d, 0xab, 0xac, 0xae, 0x62, 0x9a, 0x54, 0xfe, 0x29, 0xf3, 0xcf, 0xa8, 0xab, 0x2b, 0x7f,
+    0x30, 0x5a, 0x7a, 0xb3, 0xb1, 0xae, 0xfc, 0x41, 0x30, 0x5f, 0xce, 0x97, 0x4d, 0xca, 0x3f, 0x47,
+    0xe5, 0x3f, 0x2d, 0x94, 0x1f, 0x70, 0xca, 0xff, 0x86, 0x93, 0x69, 0x93, 0xe6, 0xcf, 0x91, 0x95,
+    0x82, 0x47, 0x4d, 0x8a, 0x5f, 0xf0, 0xe7, 0xe9, 0xc5, 0x7f, 0x48, 0x15, 0x5f, 0x26, 0x1f, 0x9c,
+    0x2c, 0xfc, 0x3d, 0x8c, 0x61, 0x5a, 0x88, 0x06, 0x24, 0xf4, 0x01, 0x57, 0x60, 0x60, 0x1a, 0x10,
+    0x34, 0x10, 0xb9, 0x74, 0x43, 0xd3, 0x55, 0x18, 0x03, 0x75, 0x02, 0xf0, 0x96, 0xfa, 0x3e, 0xdf,
+    0x36, 0x2a, 0x0c, 0x49, 0xae, 0x0b, 0x20, 0x1a, 0x39, 0x01, 0xdd, 0x84, 0xd1, 0x7e, 0x41, 0x3a,
+    0xb7, 0xaf, 0xc9, 0x4d, 0x9a, 0x90, 0x57, 0x61, 0xb6, 0x8d, 0xe8, 0xbe, 0x33, 0x20, 0x9d, 0x97,
+    0x0f, 0x2c, 0x0e, 0x53, 0xf2, 0x13, 0x48, 0x07, 0x7f, 0xfd, 0x9e, 0x45, 0x0f, 0x2c, 0x0f, 0x3d,
+    0x0a, 0x23, 0x3b, 0x06, 0x23, 0x19, 0x8d, 0x33, 0x27, 0x83, 0xe0, 0x24, 0xc5, 0xe0, 0x25, 0x51,
+    0x02, 0x0a, 0xf3, 0x40, 0xd3, 0x9e, 0x90, 0xa9, 0x3c, 0xd9, 0x92, 0x7a, 0xf7, 0xab, 0x34, 0xd9,
+    0xc5, 0xc0, 0xcd, 0x28, 0x8c, 0x19, 0x4d, 0x9d, 0x55, 0x4a, 0xfd, 0x10, 0x24, 0x06, 0x62, 0x9a,
+    0xfa, 0x6c, 0x35, 0x90, 0x9b, 0xd0, 0x8a, 0xfb, 0x64, 0xf4, 0x95, 0xf2, 0xfb, 0xb2, 0x4f, 0xdc,
+    0xd1, 0xe8, 0x2b, 0x09, 0x6a, 0x13, 0xc6, 0xce, 0x9a, 0x85, 0xab, 0x35, 0x88, 0x19, 0x86, 0x1f,
+    0xd6, 0x62, 0x38, 0x79, 0x60, 0x69, 0x10, 0x25, 0x8f, 0xce, 0x87, 0x05, 0x59, 0x87, 0xe0, 0xea,
+    0x62, 0x3c, 0xea, 0x30, 0x49, 0x97, 0xf2, 0xa8, 0xdb, 0x24, 0x83, 0xe0, 0x9a, 0x00, 0x53, 0x82,
+    0xf0, 0x03, 0x93, 0x9e, 0x53, 0xb2, 0x11, 0x49, 0xd9, 0x65, 0x0b, 0x72, 0x7e, 0x7e, 0xbe, 0xfd,
+    0x20, 0x66, 0x82, 0x30, 0xca, 0x51, 0xf7, 0x97, 0xd1, 0x2e, 0xed, 0x4d, 0xc0, 0xbf, 0x49, 0xf4,
+    0xdb, 0x24, 0x84, 0x00, 0x9e, 0x3a, 0x0c, 0x38, 0x93, 0xc3, 0x96, 0x38, 0x89, 0x99, 0x98, 0xf9,
+    0x1d, 0xac, 0xc6, 0x67, 0x1f, 0x4a, 0xa6, 0x27, 0x5b, 0xea, 0x85, 0x39, 0xf0, 0x15, 0x23, 0x54,
+    0x41, 0x8c, 0x43, 0x25, 0x39, 0x3c, 0xe2, 0x2f, 0xc8, 0x64, 0x3c, 0x2a, 0x30, 0x16, 0x87, 0x52,
+    0x86, 0xf2, 0x64, 0xbb, 0x20, 0xce, 0xbc, 0xfc, 0x3d, 0x15, 0x2b, 0x9c, 0x59, 0x39, 0xa2, 0x32,
+    0xf6, 0xcb, 0x33, 0x7f, 0x39, 0x17, 0x2a, 0xc3, 0x51, 0x2d, 0x75, 0x54, 0xe3, 0x79, 0x0d, 0x95,
+    0x32, 0xb4, 0x4c, 0xc0, 0x34, 0x37, 0x00, 0xfb, 0xbc, 0x1c, 0x8a, 0x58, 0xd0, 0x82, 0x2c, 0x98,
+    0x7b, 0x10, 0x11, 0x38, 0xb2, 0x6c, 0xcd, 0xa2, 0xa8, 0xc6, 0xe6, 0x94, 0x45, 0x34, 0x0f, 0x1f,
+    0x4c, 0xee, 0x48, 0x73, 0xdb, 0xd0, 0x0f, 0x8e, 0x24, 0xcc, 0x1d, 0x55, 0x64, 0x94, 0x8a, 0x4b,
+    0xe8, 0x2e, 0x4f, 0x0c, 0xed, 0x1d, 0xa3, 0x91, 0x71, 0x73, 0x1b, 0xcf, 0xb7, 0x5c, 0xf1, 0x87,
+    0xc0, 0x21, 0x89, 0xd8, 0x17, 0x5a, 0x0b, 0xe2, 0x8d, 0x98, 0x04, 0x46, 0xa3, 0x70, 0x15, 0x3b,
+    0x61, 0xce, 0x36, 0x20, 0x28, 0xf4, 0x0e, 0x2c, 0x15, 0x13, 0xbf, 0xed, 0xb2, 0x3c, 0x0c, 0xf6,
+    0x8e, 0x4c, 0xc6, 0x16, 0x24, 0x03, 0x59, 0x31, 0x67, 0xc9, 0xf2, 0x47, 0x86, 0x8a, 0x53, 0x51,
+    0xe2, 0x14, 0x7c, 0x71, 0x4b, 0x8c, 0x98, 0x7e, 0x39, 0x8f, 0x29, 0xdd, 0x92, 0xb5, 0x6b, 0x37,
+    0x37, 0x6e, 0x55, 0x60, 0xa9, 0x6c, 0x21, 0x09, 0x15, 0xdc, 0xcc, 0x51, 0x6f, 0x10, 0x93, 0x30,
+    0xc5, 0xe1, 0xc8, 0x65, 0x1b, 0x13, 0xe4, 0xd6, 0x80, 0x88, 0x27, 0x1e, 0x15, 0x70, 0x35, 0xeb,
+    0xe2, 0xce, 0xb1, 0x5f, 0x43, 0xe8, 0x9e, 0x4a, 0x3a, 0xb3, 0x9c, 0xe6, 0xbb, 0xac, 0x99, 0x39,
+    0x2b, 0x0a, 0xba, 0x55, 0x52, 0x67, 0x65, 0x15, 0x40, 0xc1, 0xe8, 0x52, 0xba, 0x1f, 0x11, 0x0d,
+    0x5c, 0x20, 0x29, 0x4b, 0xa2, 0xd0, 0x97, 0x84, 0x28, 0x01, 0xc8, 0x62, 0xed, 0xea, 0x9a, 0x95,
+    0x32, 0xef, 0xa7, 0xc9, 0xd6, 0xd1, 0x8c, 0xcc, 0x1d, 0x95, 0x46, 0xd6, 0x6c, 0x96, 0xa5, 0x2e,
+    0xcc, 0x50, 0x15, 0xdc, 0xd2, 0x5a, 0x15, 0x06, 0x8c, 0x8b, 0xc1, 0x46, 0x76, 0x95, 0xdc, 0x08,
+    0x63, 0x74, 0x46, 0xce, 0x73, 0x34, 0x46, 0x9d, 0xe4, 0x40, 0x4a, 0x9f, 0x54, 0xf2, 0x6d, 0x98,
+    0xdc, 0x4b, 0xd6, 0x69, 0x94, 0x60, 0xec, 0xe9, 0x57, 0x8b, 0x1e, 0x69, 0x1a, 0xdb, 0x96, 0x41,
+    0xe4, 0x11, 0xab, 0x56, 0x29, 0xb0, 0xda, 0x10, 0x23, 0x8e, 0x49, 0x31, 0xc2, 0x27, 0xf0, 0xb4,
+    0x1b, 0x18, 0xcf, 0x19, 0x90, 0x17, 0xed, 0x36, 0x71, 0x86, 0xc6, 0xb7, 0x65, 0x14, 0x7c, 0x2b,
+    0x44, 0x6a, 0x70, 0x98, 0x60, 0x6c, 0x18, 0x97, 0xdc, 0x20, 0xed, 0xf7, 0x15, 0xe9, 0x97, 0xba,
+    0x82, 0x11, 0xed, 0x90, 0x94, 0xab, 0x64, 0xa8, 0x59, 0xca, 0x22, 0xaf, 0x6a, 0x97, 0xf2, 0xac,
+    0x49, 0xca, 0xe3, 0x71, 0x4d, 0xc8, 0xb8, 0xf8, 0xa2, 0x8a, 0x7d, 0x32, 0xe4, 0x2a, 0xc8, 0xc4,
+    0x90, 0x84, 0x47, 0xe3, 0x70, 0x43, 0xa5, 0xef, 0x09, 0x33, 0x46, 0x26, 0xb3, 0xd1, 0x26, 0x23,
+    0x8c, 0xc2, 0x47, 0xb0, 0xe2, 0x75, 0x75, 0xd2, 0xf5, 0xd8, 0xb4, 0x5b, 0x0c, 0xe3, 0xa7, 0x36,
+    0x65, 0x9a, 0x69, 0x83, 0x8f, 0x52, 0xc6, 0xb3, 0x11, 0x0f, 0xa4, 0x43, 0x1a, 0xa6, 0x8e, 0xc2,
+    0x3b, 0x2e, 0x0b, 0x21, 0x02, 0xee, 0x52, 0x62, 0x32, 0xe3, 0xcb, 0x02, 0x1a, 0x1f, 0xb3, 0x6c,
+    0xf3, 0x3e, 0xcf, 0xdb, 0xd7, 0xcd, 0x85, 0x65, 0xef, 0xb3, 0xf6, 0x65, 0xc2, 0x2b, 0x43, 0xae,
+    0xf9, 0x2c, 0xd5, 0x01, 0x2d, 0xc1, 0xff, 0x55, 0x3d, 0x19, 0x49, 0x3d, 0xe1, 0xe9, 0xeb, 0x07,
+    0x4d, 0x53, 0x4a, 0xf1, 0x29, 0xb2, 0xaa, 0x29, 0x06, 0xcf, 0x8d, 0x35, 0xa9, 0xd7, 0x15, 0xac,
+    0x4c, 0x8d, 0xfb, 0xa6, 0x12, 0x8c, 0x2b, 0xec, 0x11, 0x5d, 0xb2, 0xc8, 0x66, 0x2d, 0x4d, 0xde,
+    0x50, 0xd9, 0xfb, 0x40, 0xa3, 0x1d, 0xd3, 0x04, 0xef, 0xf0, 0xf8, 0x3a, 0xb3, 0xc8, 0xbd, 0x72,
+    0xdb, 0xba, 0xdc, 0xa7, 0xa3, 0x83, 0xce, 0xfc, 0xfd, 0x0e, 0x9c, 0x48, 0xbe, 0xb7, 0x20, 0xaa,
+    0x3c, 0x93, 0xe9, 0x80, 0x96, 0x51, 0xe2, 0xdd, 0xdb, 0x1c, 0x9c, 0x12, 0x9e, 0x1b, 0x13, 0x15,
+    0x9b, 0xeb, 0xab, 0x8b, 0x40, 0x49, 0x8f, 0xfb, 0x16, 0xf7, 0x28, 0xa6, 0xfb, 0xea, 0x09, 0x86,
+    0xe8, 0xa8, 0x0a, 0x59, 0x2b, 0xf0, 0x78, 0x02, 0x8b, 0x65, 0x9b, 0x3b, 0x85, 0x1a, 0xcf, 0x1d,
+    0xf1, 0x82, 0xc4, 0x9d, 0xda, 0xa0, 0x56, 0xae, 0xae, 0x80, 0xb9, 0x09, 0x1b, 0x41, 0x8e, 0xb1,
+    0x6a, 0x70, 0xa7, 0x50, 0xe3, 0x9c, 0x9e, 0x73, 0x90, 0x73, 0x1b, 0x48, 0x00, 0xa0, 0x43, 0x04,
+    0x3f, 0xd9, 0x04, 0xd1, 0x3d, 0x07, 0xda, 0xce, 0x4e, 0xc5, 0xff, 0x00, 0x70, 0x66, 0x03, 0x58,
+    0xfa, 0xd9, 0x34, 0x79, 0x3c, 0x10, 0x2d, 0x2b, 0x71, 0x34, 0x85, 0x4b, 0x84, 0xf1, 0x17, 0xa2,
+    0x80, 0xaa, 0xcb, 0x5f, 0xae, 0xfa, 0x64, 0x4d, 0x9e, 0xc8, 0xcd, 0x95, 0x97, 0xa8, 0xc1, 0x29,
+    0xf2, 0x29, 0xb7, 0xd4, 0x5e, 0x4c, 0x96, 0xeb, 0xa3, 0x8f, 0x6b, 0xa0, 0x9c, 0x2b, 0x2f, 0xc3,
+    0x04, 0x16, 0x13, 0x0f, 0x04, 0xcd, 0x8b, 0xbe, 0x5f, 0xb0, 0xe1, 0x75, 0xd5, 0xc1, 0xdc, 0xbd,
+    0xf3, 0xeb, 0x40, 0x1b, 0xdb, 0xd2, 0x2c, 0x7b, 0x04, 0x3d, 0x34, 0xc7, 0xe3, 0xdd, 0x66, 0xc9,
+    0xd2, 0xb2, 0x12, 0x2f, 0xb3, 0xba, 0xd1, 0x57, 0xed, 0x16, 0xaf, 0x16, 0x99, 0xf6, 0x90, 0xd0,
+    0xa6, 0xd0, 0x45, 0x25, 0x5b, 0x73, 0x17, 0xd8, 0x86, 0x68, 0x48, 0x02, 0x94, 0x8a, 0x24, 0xd9,
+    0xe5, 0x68, 0x7a, 0x45, 0x02, 0xaf, 0x9f, 0x3e, 0xa5, 0xf1, 0x8a, 0xd9, 0x0f, 0x24, 0xdd, 0xb9,
+    0xe6, 0x4c, 0x2a, 0x26, 0x9f, 0x96, 0x41, 0x04, 0x51, 0x39, 0x5c, 0x4d, 0x16, 0x22, 0x6d, 0x6f,
+    0x33, 0xba, 0xc6, 0x00, 0xb3, 0xcc, 0x63, 0xe7, 0xb0, 0x5e, 0x56, 0xce, 0x0a, 0xc6, 0x79, 0x1e,
+    0xb9, 0x20, 0x42, 0xa8, 0x4d, 0x2a, 0x28, 0x0a, 0x71, 0x23, 0xe4, 0x8f, 0x0e, 0xc8, 0xa0, 0x64,
+    0xf1, 0xb9, 0xc6, 0x61, 0x8d, 0xf0, 0xe9, 0xcc, 0x96, 0xab, 0x96, 0x75, 0x7f, 0x63, 0xea, 0x50,
+    0x76, 0x10, 0x1a, 0xa3, 0x44, 0x0e, 0x42, 0x01, 0x95, 0x4d, 0x81, 0x63, 0x92, 0xc3, 0x38, 0x20,
+    0x6b, 0x0d, 0xfe, 0x39, 0x48, 0xd2, 0x0d, 0xd0, 0x55, 0x04, 0xfd, 0x81, 0xac, 0xe1, 0x94, 0xa1,
+    0x7f, 0x57, 0xfa, 0x27, 0x4e, 0x33, 0xdc, 0xa6, 0x90, 0x90, 0xa4, 0x7b, 0xdd, 0xca, 0xbf, 0x2c,
+    0x7b, 0x16, 0xc7, 0x14, 0xc5, 0xb2, 0xa1, 0x87, 0x1f, 0xfc, 0xf3, 0x20, 0x38, 0xed, 0x2b, 0xe0,
+    0x57, 0xeb, 0x24, 0xcb, 0x0d, 0xe0, 0x6a, 0xff, 0xaf, 0xe6, 0x0f, 0x4f, 0xd1, 0xc1, 0x8e, 0xb1,
+    0xdd, 0x25, 0x1a, 0x53, 0xee, 0x58, 0x05, 0x47, 0x3d, 0xe4, 0x65, 0x13, 0xb1, 0xba, 0x7a, 0x8e,
+    0x47, 0xf5, 0xb4, 0x6c, 0x84, 0x7a, 0xc8, 0xd3, 0x00, 0xe9, 0x7d, 0x79, 0xab, 0x68, 0x40, 0x26,
+    0x93, 0xa2, 0xf7, 0x62, 0xa0, 0x5a, 0xac, 0xb1, 0x68, 0x2f, 0x3a, 0x11, 0x45, 0x92, 0xc8, 0x8d,
+    0x25, 0x66, 0x59, 0xd6, 0x73, 0x87, 0xa3, 0x99, 0x65, 0x17, 0xfe, 0x78, 0x28, 0x6c, 0xaf, 0x14,
+    0xbc, 0xd4, 0x01, 0x4c, 0x65, 0xfe, 0xb7, 0xe7, 0xf2, 0x1c, 0xd3, 0xd8, 0xe8, 0x64, 0x5e, 0x0a,
+    0xd5, 0x9d, 0x25, 0x58, 0x34, 0x33, 0x7f, 0x7a, 0x36, 0x0f, 0xe0, 0x18, 0x5f, 0x4e, 0xce, 0xcf,
+    0xbd, 0xc0, 0x42, 0x8c, 0x93, 0xb2, 0x65, 0xd5, 0x7e, 0x3f, 0x0a, 0xa6, 0x3f, 0x9d, 0x4f, 0x5d,
+    0x1f, 0x3e, 0xb0, 0x33, 0x3a, 0x9d, 0x78, 0x16, 0x98, 0x7e, 0xb0, 0xfb, 0x14, 0x80, 0xde, 0xfc,
+    0x74, 0x79, 0xba, 0x44, 0xc8, 0x6c, 0x36, 0x9b, 0x49, 0x22, 0x1b, 0x7a, 0xa5, 0x36, 0x51, 0xeb,
+    0x32, 0x14, 0xee, 0x73, 0x6e, 0xeb, 0x66, 0x09, 0xe5, 0x1b, 0xde, 0x3f, 0x7c, 0x72, 0x4a, 0x89,
+    0xb5, 0xbc, 0x91, 0x53, 0xea, 0xe9, 0x4d, 0x2d, 0xd0, 0x35, 0x86, 0x45, 0x41, 0xc0, 0xd2, 0x16,
+    0x39, 0x15, 0xef, 0x6e, 0x75, 0xa6, 0xbc, 0xb9, 0xd6, 0xd6, 0x0d, 0x12, 0x0d, 0x8f, 0x69, 0x15,
+    0xb7, 0xd4, 0xd2, 0xbf, 0x49, 0xdb, 0xfe, 0xa7, 0xe7, 0x4c, 0xcb, 0xe6, 0x54, 0xdd, 0xb1, 0x15,
+    0x8d, 0x3f, 0x5b, 0xea, 0x51, 0x74, 0xfb, 0x8e, 0xaf, 0x7a, 0x85, 0x74, 0x4e, 0x5b, 0x73, 0xbf,
+    0xaa, 0xef, 0x74, 0xa8, 0x63, 0xa5, 0x7a, 0x50, 0xb9, 0x0b, 0x0e, 0x5b, 0x39, 0xcb, 0x82, 0x67,
+    0xc3, 0x6c, 0x5d, 0xc6, 0xa0, 0x12, 0x3a, 0x77, 0x74, 0xff, 0x79, 0xcf, 0xf6, 0x41, 0x4a, 0x37,
+    0x2c, 0x13, 0x25, 0x97, 0xb4, 0xe5, 0x34, 0xd9, 0xc8, 0x8f, 0xcd, 0x36, 0x3a, 0x2f, 0xeb, 0x40,
+    0x1b, 0xd1, 0x4f, 0xb2, 0xff, 0x75, 0x10, 0xcc, 0xc8, 0x06, 0xc4, 0x2d, 0x80, 0x00, 0x85, 0x1b,
+    0xe6, 0x87, 0x94, 0xf4, 0x94, 0x7e, 0xd3, 0xf9, 0x08, 0x3b, 0x0d, 0x12, 0x72, 0x59, 0xc3, 0x0d,
+    0x48, 0x59, 0xa7, 0xc1, 0xc7, 0x32, 0xcb, 0x82, 0xcf, 0x46, 0xbd, 0x65, 0xaf, 0xb9, 0xdc, 0xb1,
+    0x4a, 0xb8, 0xd2, 0x97, 0x2a, 0xe3, 0xb2, 0x1f, 0xa6, 0x4c, 0x78, 0x30, 0x22, 0x76, 0x56, 0x84,
+    0x6b, 0x71, 0x87, 0x2f, 0xce, 0x72, 0x9a, 0xe6, 0xd5, 0x02, 0x23, 0xfd, 0xc4, 0x83, 0x5d, 0x9e,
+    0xc8, 0x0b, 0xc0, 0xcb, 0x13, 0x79, 0x0d, 0x89, 0x46, 0x0f, 0x3f, 0xfc, 0xf0, 0x81, 0x78, 0x11,
+    0xe4, 0x6a, 0x57, 0x1d, 0xec, 0x7e, 0xf2, 0xa6, 0x63, 0xe7, 0xfa, 0xf2, 0x04, 0xc6, 0xed, 0xb3,
+    0xcb, 0x6a, 0x76, 0x43, 0xc3, 0xb8, 0x98, 0xe6, 0x5d, 0xbd, 0xce, 0x35, 0x47, 0xc8, 0x6f, 0x3a,
+    0xc1, 0x57, 0xcb, 0x29, 0x38, 0x9d, 0x9c, 0xe0, 0x93, 0x0a, 0xcc, 0xaa, 0x95, 0xa5, 0x2c, 0x10,
+    0x10, 0x5c, 0x79, 0x8b, 0xf9, 0x12, 0x38, 0x4e, 0x6e, 0x76, 0x69, 0x18, 0x84, 0x2c, 0x05, 0xe2,
+    0x5d, 0x63, 0xe1, 0xf6, 0xfa, 0x47, 0xf4, 0xef, 0xb8, 0xaa, 0xa8, 0xa5, 0x68, 0xec, 0xf3, 0x8b,
+    0xd3, 0x34, 0x89, 0xb2, 0xcb, 0x93, 0xad, 0x82, 0x5a, 0xd0, 0x6d, 0xa3, 0x44, 0xf4, 0xbf, 0x4c,
+    0x2a, 0xb8, 0xac, 0xe4, 0x0a, 0x6c, 0xbf, 0x74, 0x48, 0xe8, 0xe3, 0x5d, 0x6c, 0x10, 0xf2, 0x1e,
+    0x55, 0xe7, 0xfa, 0x9f, 0xa1, 0xf3, 0x3a, 0x24, 0x8e, 0x03, 0xec, 0x85, 0xa5, 0x47, 0xed, 0x16,
+    0xba, 0xc2, 0x77, 0xbf, 0xf9, 0xfb, 0xbb, 0x77, 0x4d, 0x9b, 0x65, 0xce, 0x25, 0xb7, 0xf3, 0xe0,
+    0x2d, 0xf6, 0x73, 0x17, 0x0d, 0xce, 0x60, 0xb5, 0x8a, 0x58, 0x87, 0x88, 0x0c, 0x54, 0x2c, 0xee,
+    0x5c, 0xbf, 0x02, 0xbf, 0x4d, 0xde, 0x24, 0x3e, 0xbb, 0x3c, 0x11, 0x43, 0xd6, 0xb3, 0x0b, 0x15,
+    0x60, 0xe9, 0xf5, 0x0b, 0xf1, 0x6b, 0x26, 0x14, 0xad, 0xc4, 0x05, 0xda, 0xaa, 0xca, 0x0b, 0x54,
+    0x2b, 0xf4, 0x22, 0x56, 0x9e, 0x04, 0x75, 0xbb, 0x30, 0x83, 0x9a, 0xd8, 0xc6, 0xd7, 0x2f, 0x41,
+    0x12, 0x7f, 0x17, 0x92, 0x00, 0x44, 0x63, 0x63, 0x81, 0xc2, 0x72, 0xd9, 0x71, 0x30, 0x40, 0x58,
+    0x56, 0x41, 0xc8, 0xb1, 0x2c, 0xb2, 0x2c, 0xe4, 0xd5, 0x4d, 0xe7, 0xfa, 0xe6, 0xcd, 0x78, 0x38,
+    0x35, 0x64, 0xdd, 0xb2, 0x8b, 0x27, 0xe7, 0x82, 0xb7, 0xdb, 0xcd, 0x78, 0x2a, 0x7f, 0xbf, 0x46,
+    0xb9, 0x58, 0x41, 0x34, 0x0d, 0xff, 0x51, 0xa2, 0xdd, 0xd1, 0x33, 0x69, 0x76, 0x47, 0xcf, 0xa1,
+    0xd9, 0x36, 0xa4, 0x20, 0x91, 0xc6, 0x24, 0x70, 0xc8, 0x5f, 0x0a, 0xa5, 0xa7, 0x10, 0x05, 0xe2,
+    0x15, 0xc4, 0x93, 0x94, 0x64, 0x2c, 0xce, 0xe0, 0x07, 0x26, 0x0f, 0xa6, 0x75, 0x9d, 0x48, 0xc5,
+    0x91, 0x6a, 0xd6, 0xa8, 0x4b, 0x85, 0x1f, 0xb5, 0xe8, 0xd2, 0x6b, 0x30, 0xa0, 0x6f, 0x85, 0x25,
+    0xb7, 0xeb, 0x12, 0x54, 0x3d, 0x36, 0x3d, 0x12, 0xe5, 0x2e, 0xd0, 0x79, 0xd5, 0x41, 0x2c, 0x19,
+    0x54, 0x06, 0x50, 0x7a, 0x72, 0xb0, 0xb7, 0x5b, 0xc6, 0xfc, 0xcb, 0x13, 0xbe, 0xa2, 0x41, 0x98,
+    0xdc, 0x63, 0xc2, 0x4e, 0xf0, 0xb0, 0x0b, 0xb7, 0x49, 0x98, 0xbc, 0x10, 0x24, 0x6a, 0x21, 0xc8,
+    0x39, 0xa6, 0xa0, 0xc3, 0x8a, 0xef, 0xaa, 0x33, 0xea, 0xe0, 0x25, 0xc6, 0x55, 0x07, 0xea, 0xc2,
+    0x0e, 0xe1, 0xe2, 0xc2, 0xb1, 0xe3, 0xb5, 0x4b, 0x75, 0x26, 0x65, 0x49, 0x59, 0xe1, 0x92, 0x0a,
+    0x30, 0xfa, 0xca, 0xea, 0x4c, 0xda, 0x45, 0x2d, 0xcb, 0x46, 0x1b, 0x31, 0x16, 0x2f, 0xc4, 0xe5,
+    0xb5, 0x4d, 0x59, 0xc6, 0x72, 0xc3, 0xfd, 0x70, 0x2d, 0x70, 0x60, 0x9a, 0x9f, 0x0c, 0x49, 0x31,
+    0x9d, 0xd0, 0x1f, 0x86, 0x3b, 0x9e, 0x76, 0xae, 0xc7, 0xd3, 0xcf, 0x01, 0x79, 0x0a, 0x24, 0x4f,
+    0x3f, 0x0b, 0xcd, 0x67, 0x40, 0xf3, 0xd9, 0x67, 0xa1, 0x19, 0x75, 0xe9, 0x1a, 0x1b, 0x0d, 0x76,
+    0xd8, 0x7f, 0x96, 0xd8, 0x65, 0xfe, 0xaf, 0xd5, 0x45, 0x26, 0x51, 0xa8, 0x87, 0x62, 0xa6, 0x08,
+    0x4d, 0xd7, 0xef, 0xf8, 0x4f, 0x72, 0x2b, 0xea, 0xa8, 0x1f, 0x31, 0xbb, 0x3e, 0x8a, 0xce, 0xa3,
+    0x1d, 0x47, 0x99, 0x75, 0x59, 0x3c, 0xc7, 0x4f, 0x2c, 0x7f, 0x4c, 0x20, 0x18, 0x62, 0x2e, 0x80,
+    0x61, 0xd6, 0xe2, 0x3e, 0x78, 0x03, 0x80, 0xd3, 0xcd, 0x72, 0xf4, 0x67, 0x99, 0x83, 0x23, 0x07,
+    0xc2, 0x11, 0x67, 0x98, 0xf0, 0x2b, 0x32, 0xf8, 0xdf, 0xde, 0xfe, 0xf0, 0xaa, 0xf0, 0x23, 0xd2,
+    0x1b, 0x94, 0x49, 0x42, 0x96, 0x41, 0x7c, 0x23, 0x4a, 0x8f, 0x8c, 0xd7, 0x36, 0x5e, 0x02, 0x15,
+    0x0f, 0xcb, 0x61, 0x2c, 0x09, 0x82, 0x32, 0x9b, 0xfa, 0x34, 0xac, 0x37, 0x30, 0xde, 0x84, 0x15,
+    0x3b, 0x6f, 0x05, 0xd6, 0xb2, 0x0b, 0x67, 0xc1, 0x4c, 0xa0, 0xee, 0xf2, 0xd8, 0x3a, 0x89, 0xc0,
+    0x4b, 0x5d, 0x75, 0x22, 0x46, 0x21, 0x8f, 0x5a, 0x46, 0x34, 0xbe, 0xc7, 0x4c, 0xfa, 0x9e, 0xb1,
+    0xed, 0x27, 0xd3, 0xc6, 0x13, 0x9a, 0xef, 0x62, 0xba, 0x8c, 0x2a, 0xdf, 0xaa, 0x50, 0xc7, 0x05,
+    0xc6, 0xc4, 0x74, 0x41, 0xa0, 0xb7, 0x66, 0xde, 0x3d, 0x0f, 0x96, 0xcf, 0xc1, 0xf5, 0x3d, 0x98,
+    0x4a, 0x13, 0x22, 0x91, 0x32, 0xfd, 0xb9, 0xcc, 0xe7, 0x48, 0x6f, 0x92, 0xb4, 0x11, 0xa9, 0x78,
+    0xb6, 0xa7, 0x75, 0x3a, 0x85, 0xff, 0x77, 0xa5, 0xff, 0x9f, 0x4d, 0xa7, 0x93, 0xe9, 0xf3, 0xf0,
+    0xfe, 0x9c, 0x61, 0x06, 0x6c, 0xc7, 0xbb, 0xcb, 0x10, 0xd3, 0xe7, 0x38, 0xac, 0x5d, 0xd1, 0xc4,
+    0x61, 0xff, 0x7f, 0x15, 0xed, 0x5d, 0xb2, 0x0d, 0x3d, 0xf2, 0x8f, 0x24, 0x69, 0x94, 0x46, 0x8e,
+    0x2b, 0x1c, 0x7c, 0xf2, 0xf8, 0x59, 0x78, 0xf3, 0x72, 0xb5, 0x4a, 0xd9, 0x0a, 0x0a, 0xcb, 0x26,
+    0xfc, 0xb4, 0x58, 0xf0, 0x87, 0xb5, 0xfd, 0x15, 0x7f, 0xf9, 0x49, 0xac, 0xae, 0x46, 0xbe, 0x0a,
+    0xfd, 0x73, 0x5c, 0x4d, 0x73, 0x54, 0xb0, 0x44, 0x06, 0xd9, 0xb2, 0x2c, 0xf0, 0x66, 0xbb, 0xe5,
+    0x26, 0xcc, 0x3b, 0xd7, 0xb7, 0x28, 0xe0, 0x5b, 0xe9, 0x55, 0x5b, 0xe2, 0x9e, 0x2d, 0x29, 0x45,
+    0x1f, 0xfc, 0x8c, 0x58, 0x50, 0x54, 0xdd, 0x96, 0x50, 0x70, 0xbb, 0xcf, 0xa0, 0x54, 0x6e, 0xcf,
+    0x1f, 0xef, 0x1f, 0x3a, 0x0d, 0x39, 0xd7, 0xf5, 0xcf, 0xdb, 0x3c, 0xc4, 0x87, 0xb4, 0xfc, 0x97,
+    0xcb, 0x25, 0xe7, 0xf8, 0x8e, 0x8f, 0xa9, 0x59, 0xf7, 0xb2, 0x69, 0xfb, 0xad, 0x48, 0x90, 0xbf,
+    0x4b, 0xd3, 0x24, 0xcd, 0x74, 0x28, 0x22, 0x77, 0x76, 0x18, 0x9f, 0x3a, 0x00, 0x06, 0x52, 0x56,
+    0x7d, 0x33, 0x4f, 0x30, 0x73, 0x54, 0x2d, 0xdb, 0xc6, 0xcf, 0x13, 0xfa, 0x45, 0xfb, 0xd2, 0x16,
+    0xfa, 0xc5, 0x8c, 0x03, 0x70, 0x3b, 0xd7, 0xff, 0xe0, 0x9f, 0x8f, 0x4e, 0x77, 0x74, 0x14, 0x7e,
+    0xb0, 0xb3, 0xc1, 0x87, 0x61, 0x01, 0xfc, 0xd5, 0xeb, 0x9f, 0x3f, 0x35, 0x89, 0x10, 0xbf, 0xca,
+    0x22, 0x17, 0x1b, 0x20, 0xd8, 0xb6, 0xd0, 0x7b, 0x1b, 0xbc, 0x6f, 0x25, 0xcb, 0x6b, 0xfe, 0xb1,
+    0x6c, 0x71, 0x40, 0x4e, 0x13, 0x6e, 0xf3, 0xeb, 0x17, 0xbd, 0x60, 0x17, 0x0b, 0x42, 0x7b, 0x45,
+    0x2f, 0xa8, 0x1c, 0x59, 0xee, 0x7f, 0xf0, 0x7b, 0xa1, 0xdf, 0x57, 0x5a, 0x38, 0x29, 0xcb, 0x77,
+    0x69, 0x4c, 0xfc, 0xc4, 0xdb, 0x6d, 0x58, 0x9c, 0x0f, 0x57, 0x2c, 0xff, 0x2e, 0x62, 0xf8, 0xf1,
+    0xaf, 0x72, 0x71, 0xd1, 0x9a, 0xe1, 0x3f, 0x1e, 0x28, 0x54, 0x52, 0x28, 0xcc, 0x6f, 0x29, 0x78,
+    0x08, 0x72, 0xa5, 0x36, 0x83, 0x68, 0x7c, 0xb7, 0x65, 0xa9, 0x78, 0xc4, 0x38, 0x1a, 0x94, 0xe3,
+    0x11, 0xe6, 0x53, 0xd9, 0x1d, 0xef, 0x49, 0xd2, 0x28, 0x63, 0xd5, 0x8c, 0x48, 0xc3, 0xee, 0xf8,
+    0x82, 0x3b, 0x71, 0xdd, 0xb1, 0x53, 0xa6, 0x31, 0x45, 0xb8, 0x4b, 0x19, 0xf5, 0xf7, 0xb5, 0x9d,
+    0xe8, 0xb3, 0xee, 0x64, 0x7c, 0xb6, 0x4f, 0x7a, 0x49, 0x1c, 0x03, 0x23, 0xcb, 0x69, 0x71, 0x88,
+    0x8b, 0xf2, 0x10, 0x9c, 0x7b, 0xef, 0xc0, 0x36, 0x52, 0x38, 0x44, 0xbc, 0x8b, 0xa2, 0x6a, 0x6a,
+    0x9b, 0x44, 0x91, 0x7d, 0x26, 0x4b, 0xbc, 0x7b, 0x96, 0xd7, 0x86, 0xc3, 0x0c, 0x94, 0xfe, 0x55,
+    0x0a, 0x3e, 0x14, 0x8b, 0xcd, 0x2b, 0x81, 0xb0, 0x9a, 0x06, 0xc6, 0xbc, 0x02, 0x4d, 0x03, 0x21,
+    0x30, 0x3b, 0x58, 0xde, 0x28, 0xf9, 0x6f, 0xb6, 0x87, 0x89, 0x2e, 0xc5, 0x5e, 0xd2, 0xdd, 0x2e,
+    0xbc, 0xe3, 0x83, 0xdd, 0x8b, 0x17, 0xba, 0x04, 0xb1, 0x63, 0xf9, 0x0e, 0x49, 0xef, 0x6d, 0x58,
+    0x96, 0xd1, 0x15, 0x53, 0x65, 0x89, 0xb0, 0xa0, 0x8a, 0xbc, 0x12, 0x72, 0xee, 0xf2, 0x23, 0x76,
+    0x95, 0x3e, 0x62, 0x18, 0x90, 0xde, 0x17, 0x2c, 0x52, 0xb7, 0x54, 0x2a, 0x50, 0x2d, 0x7b, 0x2a,
+    0x3f, 0xb1, 0x68, 0x88, 0x1e, 0xfa, 0x5b, 0x71, 0x3b, 0x04, 0x80, 0x25, 0xd2, 0x0b, 0x75, 0x05,
+    0xd7, 0xcc, 0x1f, 0xc3, 0x2c, 0x1f, 0x52, 0x1f, 0xb0, 0x22, 0x85, 0x26, 0xd2, 0x8a, 0xd9, 0x26,
+    0x6e, 0xd0, 0x7b, 0x9a, 0xe2, 0x4c, 0xb2, 0xcb, 0xd5, 0x65, 0x36, 0x6a, 0x34, 0x91, 0x41, 0x2a,
+    0x5c, 0x6c, 0xab, 0x2b, 0xbc, 0x95, 0xba, 0x94, 0x6d, 0x92, 0x07, 0x56, 0x27, 0xf0, 0x09, 0xaf,
+    0x73, 0x46, 0x23, 0x5d, 0xcf, 0x4b, 0x98, 0x60, 0x0f, 0x18, 0x24, 0xfc, 0x77, 0x28, 0x0e, 0x0d,
+    0x41, 0x5e, 0xde, 0x80, 0x19, 0xb6, 0x14, 0x25, 0x1e, 0x8d, 0x6e, 0xf3, 0x04, 0x14, 0x82, 0xa1,
+    0x3d, 0xfd, 0x00, 0x4e, 0xbd, 0x57, 0xc8, 0x58, 0x45, 0x4c, 0x3c, 0x9a, 0x7b, 0x6b, 0xd2, 0x03,
+    0xbf, 0x6a, 0x97, 0x89, 0xa2, 0x27, 0x15, 0x2b, 0x4c, 0x0a, 0x33, 0x20, 0x4f, 0x50, 0xc7, 0x71,
+    0xb4, 0x93, 0xa8, 0xd1, 0x96, 0x19, 0xb4, 0x0d, 0x84, 0x26, 0x1e, 0x41, 0xa2, 0x9d, 0x12, 0x28,
+    0x02, 0x93, 0xe8, 0x81, 0xfd, 0x20, 0xbe, 0xed, 0x51, 0xe7, 0x18, 0x37, 0x21, 0x64, 0x26, 0xc8,
+    0xcf, 0xe0, 0xab, 0xae, 0x2f, 0x72, 0xd1, 0x15, 0xd8, 0x03, 0x77, 0x0e, 0x5d, 0xf2, 0xaf, 0x7f,
+    0x11, 0x65, 0x10, 0x6f, 0x7d, 0xba, 0x0d, 0x2c, 0xe3, 0xcb, 0x6c, 0xea, 0xc3, 0x4d, 0x3b, 0x65,
+    0x01, 0x4b, 0x33, 0xde, 0x7d, 0xbc, 0x02, 0x07, 0x13, 0xfb, 0xc9, 0xe3, 0x70, 0x83, 0x47, 0x7c,
+    0xc3, 0xdb, 0xe9, 0x5f, 0x7f, 0x5d, 0x1f, 0xec, 0x75, 0x7b, 0x72, 0x9b, 0xc3, 0x6f, 0x39, 0xa0,
+    0xae, 0x44, 0x9a, 0x17, 0x04, 0xa9, 0xe8, 0x77, 0xfb, 0x62, 0x29, 0xcb, 0x2e, 0x4c, 0x9f, 0xaa,
+    0x22, 0xfb, 0x46, 0x12, 0x4d, 0x16, 0xc5, 0x91, 0xec, 0xea, 0x46, 0xb7, 0xdb, 0x68, 0xdf, 0x20,
+    0x4d, 0x3c, 0x40, 0x0c, 0x49, 0x07, 0x8d, 0xc2, 0xdf, 0x39, 0x0f, 0xc5, 0x12, 0x8d, 0x25, 0x4d,
+    0x78, 0xf8, 0xbd, 0x56, 0xe1, 0xe3, 0xb1, 0xa1, 0x8e, 0xc2, 0x7f, 0x99, 0xe7, 0x69, 0x08, 0x21,
+    0x0a, 0x8c, 0xa2, 0xba, 0x53, 0xeb, 0x0e, 0x14, 0x24, 0x8a, 0x5c, 0x4a, 0x47, 0xf5, 0xd7, 0x3c,
+    0xae, 0x5c, 0x8c, 0xd2, 0xe2, 0xad, 0x19, 0xbd, 0x5c, 0x6c, 0xca, 0xa9, 0x18, 0x37, 0x5c, 0x8b,
+    0x7a, 0xb2, 0xf2, 0x40, 0x78, 0x1e, 0x5e, 0x8f, 0xf3, 0x5e, 0x31, 0x3f, 0x55, 0xd9, 0x39, 0xee,
+    0x1e, 0x32, 0x0c, 0x16, 0x7b, 0xb0, 0xec, 0x35, 0xc0, 0xed, 0xe1, 0xf1, 0x4c, 0x56, 0x46, 0xe0,
+    0x14, 0x00, 0xef, 0x2f, 0xbf, 0x56, 0x70, 0xde, 0x2e, 0x7f, 0x83, 0x98, 0x31, 0xbc, 0x67, 0xfb,
+    0x4c, 0x6c, 0x19, 0x42, 0x92, 0xf7, 0x1d, 0x44, 0x3a, 0xc5, 0xc7, 0xc0, 0xa4, 0x79, 0x22, 0x3c,
+    0x2d, 0x2e, 0xff, 0x05, 0xe6, 0x7e, 0xe5, 0xd4, 0xef, 0x62, 0x9f, 0x05, 0x61, 0x0c, 0x67, 0x01,
+    0xc5, 0xd5, 0xa7, 0xd0, 0xa4, 0x4d, 0x00, 0x36, 0x2f, 0xac, 0x2b, 0xaf, 0x08, 0xa4, 0xe0, 0xc5,
+    0xb6, 0xbb, 0x6c, 0xdd, 0x13, 0x27, 0xfb, 0xf9, 0x1f, 0x3f, 0x7c, 0x0b, 0x59, 0x73, 0x12, 0xe3,
+    0xb5, 0x29, 0x27, 0xeb, 0x2f, 0xa4, 0x7b, 0xd5, 0x85, 0xbf, 0x2d, 0xf3, 0xb7, 0x20, 0xea, 0x78,
+    0x55, 0x91, 0xd9, 0xef, 0xab, 0x66, 0xde, 0xaf, 0x29, 0x2f, 0x47, 0xf6, 0x5b, 0x12, 0xc6, 0xbd,
+    0xee, 0xd7, 0x5d, 0xdd, 0x37, 0xd2, 0x6c, 0x1f, 0x7b, 0xaa, 0xca, 0x86, 0x7f, 0x63, 0x79, 0x6f,
+    0x4b, 0xf3, 0xb5, 0xc9, 0x62, 0x70, 0x08, 0xc0, 0x61, 0xfa, 0x48, 0xc3, 0x9c, 0x04, 0x0c, 0xac,
+    0x84, 0xaf, 0x1a, 0x90, 0x8f, 0xe0, 0x56, 0xc0, 0x64, 0x40, 0x9a, 0x71, 0x02, 0xb9, 0x61, 0x92,
+    0x82, 0x68, 0x9f, 0xcc, 0x40, 0x05, 0x9b, 0x87, 0xc9, 0x7d, 0x5d, 0x7b, 0xf0, 0xdd, 0x48, 0xcc,
+    0x1e, 0x45, 0xa2, 0xda, 0xeb, 0x7e, 0xff, 0xee, 0xdd, 0x0d, 0xc1, 0x43, 0xe3, 0x7a, 0x71, 0x39,
+    0x62, 0x8d, 0x1e, 0xf2, 0x5c, 0xb8, 0xea, 0xb7, 0x2c, 0x89, 0x7b, 0x87, 0xce, 0x74, 0x03, 0x45,
+    0xb9, 0x24, 0xd7, 0xa6, 0x3d, 0x8d, 0x47, 0xd3, 0xa8, 0xdd, 0xb0, 0x7c, 0x8d, 0xdf, 0xc8, 0xe8,
+    0xde, 0xbc, 0xbd, 0x7d, 0xd7, 0x1d, 0x68, 0x73, 0xe2, 0x6a, 0x23, 0x5b, 0x00, 0x37, 0xba, 0xd2,
+    0x0c, 0x9c, 0x77, 0x90, 0x4f, 0x76, 0x61, 0x39, 0xba, 0x81, 0xd0, 0xe3, 0x8f, 0x3e, 0x4f, 0x3e,
+    0x38, 0x8f, 0x8f, 0x8f, 0xbc, 0xe3, 0xe3, 0xec, 0xd2, 0x48, 0x88, 0xd6, 0x07, 0x7e, 0xe9, 0xd0,
+    0xd0, 0xa6, 0x17, 0xa6, 0xca, 0xa3, 0xf6, 0x7d, 0x7c, 0xea, 0x5b, 0xe5, 0xcc, 0xdd, 0x21, 0xdd,
+    0x47, 0x09, 0x45, 0x57, 0xf2, 0xf1, 0xe9, 0xa2, 0x25, 0x6a, 0x54, 0xeb, 0xc4, 0x81, 0x4d, 0x26,
+    0xea, 0xa1, 0xa2, 0xdf, 0xb8, 0x5b, 0xc5, 0xf2, 0x74, 0x8c, 0xb4, 0x91, 0xc8, 0x4d, 0x86, 0x39,
+    0x95, 0x04, 0x32, 0xe4, 0x35, 0x08, 0xb8, 0x05, 0xfd, 0xf7, 0x05, 0x39, 0xa4, 0x08, 0x36, 0xdd,
+    0x01, 0xc8, 0x6d, 0xaa, 0x22, 0x51, 0xd8, 0x1d, 0xb5, 0xbc, 0x68, 0x00, 0x56, 0xdf, 0x6c, 0xc6,
+    0xd3, 0x1e, 0xde, 0xc7, 0xa8, 0xc4, 0xe3, 0x99, 0x70, 0x8c, 0x5c, 0x5e, 0x11, 0x77, 0xdc, 0x10,
+    0xaa, 0x3e, 0x12, 0xf1, 0xf5, 0xa0, 0xee, 0xcb, 0xea, 0x4e, 0x70, 0x41, 0xfe, 0x96, 0x24, 0x3e,
+    0x38, 0x61, 0x2f, 0x02, 0xd5, 0xe8, 0xe2, 0x4b, 0xc3, 0x2e, 0x69, 0x64, 0x5b, 0x81, 0x62, 0x32,
+    0xfd, 0x24, 0x14, 0xe8, 0x3e, 0x53, 0x48, 0xe2, 0x4b, 0x34, 0x9b, 0xb0, 0x09, 0x4b, 0x2b, 0x9c,
+    0xef, 0xc1, 0x35, 0x93, 0x9b, 0x37, 0x25, 0x98, 0x25, 0xad, 0xc0, 0xd4, 0x93, 0x03, 0xf0, 0x89,
+    0xe9, 0x2d, 0xd6, 0x0e, 0x35, 0x77, 0xac, 0x55, 0x14, 0x38, 0x79, 0x51, 0x15, 0xd1, 0x22, 0xd0,
+    0x54, 0xf7, 0x5d, 0x10, 0x70, 0xf5, 0xc0, 0x81, 0xeb, 0x87, 0x38, 0x7f, 0x51, 0xdb, 0x53, 0xdc,
+    0x37, 0x35, 0xed, 0x71, 0x47, 0xe6, 0x1e, 0xb5, 0x5e, 0xb6, 0xef, 0x12, 0x2b, 0xee, 0x32, 0x74,
+    0xb6, 0x59, 0xd7, 0xdc, 0xaf, 0x55, 0xca, 0x76, 0x00, 0x62, 0xc9, 0xdd, 0x16, 0xbf, 0x56, 0x7b,
+    0x27, 0x16, 0x9a, 0x50, 0xca, 0x92, 0xd9, 0x0e, 0x41, 0xa9, 0xb4, 0x90, 0x8a, 0xaf, 0xba, 0x0a,
+    0xbb, 0xb8, 0x31, 0x69, 0x05, 0x89, 0xa9, 0x19, 0x0a, 0x0a, 0x7e, 0xed, 0x03, 0x38, 0xc4, 0xab,
+    0xbf, 0x3a, 0xf4, 0x8b, 0x86, 0x8d, 0x2d, 0xec, 0xb1, 0xd0, 0x56, 0x29, 0x95, 0xe6, 0x7c, 0xde,
+    0xc3, 0x16, 0xc3, 0x8a, 0x7e, 0xe2, 0x7d, 0xc8, 0x5e, 0x29, 0xd1, 0x3e, 0x3a, 0xb0, 0x91, 0xe1,
+    0xb4, 0xde, 0x7f, 0x8b, 0xdf, 0xdd, 0x28, 0x32, 0x10, 0xf5, 0xc2, 0x4f, 0xcd, 0x40, 0xf8, 0x2a,
+    0x83, 0xc0, 0xf7, 0xfc, 0x77, 0x73, 0x0d, 0xaf, 0x10, 0x7e, 0xa2, 0x98, 0x48, 0x91, 0x02, 0x1c,
+    0xf7, 0x23, 0xef, 0x61, 0x2a, 0xbb, 0xd0, 0x89, 0xc6, 0x9a, 0x54, 0xc3, 0x5f, 0x5e, 0xb1, 0xab,
+    0xc8, 0x8b, 0x55, 0x36, 0x06, 0x55, 0x55, 0x2d, 0x26, 0x37, 0xa2, 0x47, 0x9e, 0xf0, 0x07, 0x7b,
+    0x3c, 0xbd, 0x91, 0x03, 0x41, 0xc0, 0x47, 0x2c, 0x20, 0x55, 0x72, 0x2d, 0x00, 0xf9, 0x17, 0x5b,
+    0x12, 0x91, 0x00, 0xf2, 0xcf, 0xf8, 0x3d, 0x8c, 0xae, 0x71, 0x0a, 0xac, 0x90, 0xb5, 0x53, 0x94,
+    0x57, 0xfd, 0xb5, 0x72, 0x91, 0xa3, 0x50, 0xcb, 0x6d, 0x53, 0x9d, 0x0a, 0x58, 0xc6, 0x59, 0xbb,
+    0xbc, 0xef, 0xe8, 0x87, 0x19, 0xdf, 0xd4, 0xbd, 0xb0, 0xef, 0xd1, 0x78, 0xcf, 0xf1, 0xab, 0x01,
+    0x85, 0x45, 0xe5, 0xd3, 0x9b, 0x03, 0xd8, 0x2a, 0x2a, 0xcb, 0xba, 0x1f, 0x99, 0xc1, 0x69, 0x50,
+    0x98, 0x2b, 0x7e, 0xaf, 0xf1, 0xb6, 0x91, 0xa4, 0x06, 0xb0, 0x4d, 0x3c, 0x6e, 0x50, 0x74, 0xd1,
+    0xe6, 0x50, 0xd3, 0x66, 0xed, 0xfe, 0xc9, 0x64, 0x79, 0xb9, 0xdc, 0xe4, 0x74, 0x39, 0x61, 0xf5,
+    0x2a, 0x7a, 0x2f, 0x05, 0xc9, 0xb4, 0x5c, 0x6b, 0x91, 0xde, 0xdb, 0xb8, 0xcf, 0xe9, 0xb6, 0x4f,
+    0x06, 0x41, 0xbf, 0x29, 0xad, 0x36, 0x32, 0x24, 0x8c, 0x8c, 0xc2, 0x99, 0xb7, 0x17, 0x9c, 0xc8,
+    0x00, 0x9e, 0x8a, 0x14, 0xb9, 0x83, 0x4c, 0x17, 0xbb, 0x27, 0xf0, 0xe1, 0xe4, 0x61, 0x7c, 0x22,
+    0xfd, 0xdc, 0x85, 0x11, 0xbd, 0x8c, 0x60, 0x71, 0x5c, 0xd5, 0x5c, 0x75, 0x47, 0xba, 0x7c, 0x2f,
+    0xc0, 0x09, 0x20, 0x1b, 0x58, 0x93, 0x80, 0x86, 0xa8, 0x85, 0xfd, 0x43, 0x25, 0xc3, 0x86, 0xa5,
+    0x2b, 0x26, 0xd1, 0xb2, 0xa8, 0x9e, 0xf5, 0xf1, 0x79, 0x33, 0x93, 0x51, 0xab, 0x86, 0x2a, 0x92,
+    0x1d, 0x59, 0x3b, 0x08, 0x88, 0xb2, 0x3c, 0x50, 0x02, 0x21, 0x1f, 0xb1, 0x67, 0xe8, 0x5a, 0x95,
+    0xc2, 0xa9, 0x7c, 0x0e, 0x2a, 0xbe, 0xb3, 0x05, 0x8b, 0x2a, 0x02, 0xb1, 0xb3, 0xa1, 0x43, 0xc2,
+    0x9f, 0x74, 0xdd, 0x24, 0x51, 0x84, 0xf5, 0x85, 0x99, 0x03, 0x7d, 0x51, 0x36, 0xd3, 0x6a, 0x59,
+    0xa1, 0xd2, 0x65, 0xc3, 0x46, 0x04, 0xbe, 0xe5, 0x83, 0xb8, 0xd2, 0x2b, 0x15, 0x6b, 0x40, 0xc6,
+    0xa3, 0xd1, 0xe8, 0xa0, 0xc8, 0xa0, 0x7c, 0xd8, 0x36, 0x61, 0x6f, 0x44, 0xce, 0xdb, 0x4e, 0x25,
+    0xca, 0x6a, 0xd9, 0x45, 0x23, 0x89, 0x47, 0x75, 0x62, 0x90, 0x13, 0xdf, 0xe1, 0x73, 0x44, 0xa8,
+    0xb6, 0x18, 0xdd, 0xd4, 0xb9, 0x21, 0x9b, 0x0b, 0x62, 0x4d, 0xb2, 0x83, 0x30, 0x59, 0x53, 0x61,
+    0x8d, 0x9b, 0x17, 0x47, 0x36, 0xea, 0x44, 0x73, 0x12, 0xe1, 0x21, 0xa9, 0x98, 0xe0, 0x56, 0x18,
+    0x2a, 0x53, 0x13, 0x2f, 0x25, 0x55, 0x2b, 0x10, 0x7b, 0x86, 0x49, 0x9c, 0x6c, 0x19, 0xba, 0xa7,
+    0xe6, 0x56, 0x9a, 0xc6, 0x66, 0x85, 0x04, 0x0b, 0x2c, 0xd9, 0x24, 0xd4, 0xc0, 0xb1, 0x87, 0xbc,
+    0x56, 0xc9, 0xd5, 0x7c, 0x45, 0xa9, 0xa4, 0x42, 0xeb, 0xfe, 0xeb, 0xf6, 0xed, 0x4f, 0x43, 0x9e,
+    0x26, 0xe1, 0xf6, 0x21, 0xf7, 0x03, 0x06, 0x47, 0xda, 0x9c, 0xc1, 0x53, 0x2b, 0x91, 0xa2, 0x6e,
+    0x68, 0x3f, 0xb1, 0x5d, 0x12, 0x4f, 0x2d, 0x66, 0x80, 0x2f, 0xfc, 0x7e, 0xde, 0x02, 0xa5, 0x2c,
+    0x6b, 0x14, 0xfe, 0x3f, 0xd9, 0xf2, 0x96, 0xf7, 0x91, 0xad, 0x08, 0x35, 0xf5, 0xf9, 0x14, 0xf1,
+    0xa3, 0x04, 0xb9, 0x6b, 0x52, 0xba, 0xcf, 0x65, 0xd6, 0x92, 0x49, 0xb5, 0x28, 0x71, 0x43, 0xe2,
+    0x92, 0x2d, 0x4e, 0x4e, 0x30, 0xcd, 0xc1, 0x96, 0x20, 0x9e, 0x60, 0xc8, 0x5f, 0x73, 0x40, 0xce,
+    0x56, 0xa8, 0xcb, 0xa3, 0xa6, 0x2a, 0x8f, 0xd9, 0x31, 0x6a, 0x52, 0x52, 0x81, 0xad, 0x7c, 0x9d,
+    0xfc, 0xb2, 0x79, 0xfe, 0x98, 0x5d, 0x7c, 0xa2, 0x6a, 0x71, 0xdc, 0x47, 0xaa, 0x95, 0x2c, 0x19,
+    0x2f, 0x8e, 0xd1, 0x35, 0x5e, 0x59, 0xda, 0xd4, 0xec, 0x78, 0x2d, 0x3b, 0xae, 0x75, 0x83, 0xf2,
+    0x97, 0x6e, 0x7b, 0x9b, 0x26, 0x79, 0x82, 0xf7, 0x46, 0xc3, 0x35, 0xcd, 0xde, 0x3e, 0xc6, 0x37,
+    0x29, 0xf0, 0x2c, 0xcd, 0xf7, 0x43, 0x8f, 0x46, 0x11, 0x96, 0xa4, 0x03, 0xd2, 0x85, 0xdc, 0xa2,
+    0x6f, 0x43, 0xc4, 0xd5, 0x08, 0x96, 0x58, 0x2a, 0x65, 0x4b, 0x08, 0x94, 0xef, 0xd1, 0x64, 0xf0,
+    0x5b, 0xf0, 0x9c, 0x16, 0x37, 0x73, 0xd5, 0x37, 0x8e, 0x58, 0x27, 0xf9, 0xb8, 0x83, 0x29, 0xe6,
+    0x6a, 0x54, 0xd3, 0x86, 0xf4, 0xbc, 0x28, 0xc9, 0x58, 0xbb, 0xbd, 0xd5, 0x2f, 0x57, 0xd4, 0x73,
+    0x0b, 0xcd, 0xb2, 0x1d, 0xbb, 0xcd, 0x65, 0xf2, 0xf9, 0xea, 0xaa, 0xc0, 0x34, 0xd2, 0x01, 0x99,
+    0xe8, 0x31, 0xa6, 0x31, 0xf1, 0x3c, 0xc6, 0x40, 0x9f, 0x1a, 0x7c, 0x84, 0x2d, 0x75, 0x92, 0x77,
+    0xce, 0x47, 0x64, 0x4f, 0x59, 0x73, 0xea, 0x24, 0x81, 0x98, 0xd9, 0x93, 0x52, 0x99, 0xe0, 0xbb,
+    0x1e, 0xa5, 0xc0, 0xcb, 0x44, 0xb5, 0x80, 0xa3, 0x58, 0x5a, 0x75, 0xbb, 0xb6, 0x8d, 0xea, 0xe3,
+    0x17, 0xd8, 0xcb, 0x5f, 0x02, 0x70, 0x9b, 0xfe, 0xe2, 0x0b, 0x59, 0xa0, 0x65, 0x5a, 0x45, 0x60,
+    0x16, 0x69, 0x06, 0x24, 0x74, 0x2b, 0x1a, 0x09, 0x7c, 0x2f, 0x77, 0x36, 0xed, 0x24, 0xe0, 0x0b,
+    0x95, 0xfa, 0x46, 0x1c, 0xc5, 0x8d, 0xee, 0x7c, 0x3e, 0x69, 0xdc, 0x8a, 0x8f, 0x4c, 0xea, 0x5b,
+    0x71, 0xb4, 0x19, 0x67, 0xf9, 0x38, 0x41, 0xdb, 0x28, 0x46, 0xef, 0x0e, 0xf2, 0xab, 0x7a, 0xc0,
+    0x51, 0xc7, 0xcb, 0xe7, 0xee, 0xf8, 0xbf, 0x67, 0xd5, 0x0e, 0xa4, 0x7c, 0x85, 0xa1, 0xb1, 0x5d,
+    0x67, 0xfa, 0x76, 0xb7, 0x8c, 0xc2, 0x6c, 0x7d, 0xb7, 0x49, 0x7c, 0x26, 0x38, 0xcf, 0xdb, 0xca,
+    0xee, 0xa7, 0x67, 0xc8, 0x52, 0x7b, 0x44, 0xfb, 0xf2, 0x50, 0x8a, 0x6c, 0xe8, 0x70, 0x06, 0xd9,
+    0xa1, 0xf4, 0x2f, 0x3d, 0xd9, 0x27, 0x33, 0xe3, 0x9d, 0xb4, 0xe7, 0xaf, 0xbf, 0x96, 0x96, 0x3d,
+    0xe4, 0x35, 0xaa, 0xc8, 0xcb, 0x39, 0xc5, 0x76, 0x07, 0x80, 0xfd, 0x11, 0xbf, 0xa7, 0x34, 0x32,
+    0x0b, 0xf0, 0x47, 0x47, 0xc3, 0xd2, 0x58, 0x78, 0x0b, 0xb7, 0xb4, 0x16, 0xf9, 0xd0, 0xbe, 0x3b,
+    0x28, 0x1a, 0x7b, 0x46, 0xdd, 0xd5, 0x98, 0x2c, 0x2a, 0xa5, 0x4e, 0x03, 0x73, 0x8a, 0xde, 0x8f,
+    0xf2, 0x3a, 0x0f, 0x24, 0x48, 0x7d, 0x9f, 0x3b, 0x0b, 0xbc, 0x7d, 0x04, 0xdf, 0x95, 0xc2, 0x0a,
+    0xfe, 0xec, 0x04, 0x28, 0x30, 0xb8, 0x69, 0xc6, 0x31, 0x8c, 0x43, 0xdb, 0x94, 0xa7, 0x6b, 0xaf,
+    0x58, 0x40, 0x77, 0x51, 0xae, 0xa2, 0xb6, 0xbb, 0x09, 0xa5, 0xcb, 0x5a, 0x73, 0x5c, 0xa5, 0xd1,
+    0x2f, 0x9a, 0x7c, 0xc3, 0x30, 0x4f, 0x43, 0xf0, 0x67, 0x83, 0x7a, 0x8c, 0xd4, 0x6e, 0xda, 0x5b,
+    0x1d, 0xc4, 0x37, 0xc4, 0x25, 0xda, 0xcd, 0xbf, 0x06, 0x03, 0x0d, 0x7e, 0xd1, 0xe4, 0x17, 0xda,
+    0xd1, 0xa3, 0xc9, 0x2f, 0x9a, 0x3c, 0x43, 0xfb, 0x56, 0x34, 0xf9, 0x45, 0x93, 0x67, 0x68, 0xdc,
+    0x5a, 0x1a, 0xfd, 0xa2, 0xc9, 0x37, 0xb4, 0x63, 0xad, 0x0c, 0x7e, 0xd1, 0xee, 0x23, 0x0e, 0x9c,
+    0x5b, 0x31, 0xf5, 0xc5, 0x21, 0x3f, 0x21, 0xb9, 0xaf, 0x07, 0xa4, 0x8b, 0x9a, 0x9a, 0xa0, 0xe4,
+    0xf1, 0xa5, 0x9c, 0xde, 0xc0, 0xc2, 0x37, 0x71, 0x05, 0x4d, 0xf5, 0x3d, 0x88, 0x53, 0xdb, 0x53,
+    0xbe, 0xa9, 0xb3, 0xef, 0x41, 0x6b, 0x2a, 0xf0, 0x0c, 0x23, 0x16, 0xaf, 0xf2, 0x35, 0xb9, 0x46,
+    0x47, 0x55, 0xd7, 0xcc, 0xa2, 0x8d, 0xcf, 0x35, 0x74, 0x2b, 0x70, 0x14, 0x5b, 0x0f, 0x25, 0x54,
+    0x05, 0x59, 0x47, 0xa2, 0x10, 0x2c, 0x15, 0x28, 0x8a, 0xad, 0x6d, 0x28, 0x1a, 0xdc, 0x48, 0x19,
+    0x74, 0x6d, 0x7e, 0xc4, 0x88, 0xbe, 0x2a, 0x8b, 0xb0, 0xc3, 0xd5, 0x12, 0xeb, 0xda, 0x57, 0xda,
+    0xdc, 0x36, 0xbf, 0xe8, 0xee, 0x3e, 0xa3, 0x33, 0x82, 0x6f, 0xde, 0xd4, 0x9c, 0x10, 0x96, 0x0f,
+    0x8b, 0xd7, 0x24, 0x35, 0x07, 0xd7, 0xbf, 0xa8, 0x5d, 0x7c, 0xb0, 0x1d, 0x7b, 0x4d, 0x63, 0x91,
+    0x41, 0xf5, 0x38, 0xc5, 0xa6, 0xeb, 0x37, 0x5f, 0xbc, 0xb4, 0xbe, 0xfa, 0xa8, 0x2d, 0xb6, 0xf9,
+    0xf4, 0x93, 0x13, 0xf2, 0x16, 0xbf, 0x54, 0x9b, 0xaf, 0x59, 0x91, 0x28, 0x52, 0x1e, 0x84, 0x48,
+    0x98, 0x11, 0xa8, 0xe6, 0x48, 0xb6, 0x81, 0xf4, 0x99, 0xf0, 0xef, 0xec, 0x0d, 0x60, 0x05, 0x7e,
+    0x95, 0xce, 0xbb, 0x17, 0xcb, 0x79, 0x97, 0x9b, 0x6c, 0x76, 0xc0, 0x9a, 0x4d, 0x92, 0xe2, 0x6b,
+    0x3c, 0x48, 0x45, 0xa3, 0xfd, 0x50, 0x2b, 0x91, 0x7c, 0x16, 0xd1, 0xfd, 0x1b, 0xd4, 0x8d, 0x63,
+    0x02, 0xd7, 0x37, 0xe4, 0x74, 0x44, 0xf0, 0xdf, 0x06, 0x51, 0x2e, 0x10, 0x2c, 0xcf, 0x7c, 0x94,
+    0xcc, 0xd3, 0xf4, 0xf8, 0xc7, 0x55, 0xc3, 0x42, 0x07, 0xd5, 0x60, 0xfb, 0x51, 0x7f, 0x67, 0x25,
+    0x14, 0xe6, 0xe9, 0x13, 0x0b, 0x16, 0x45, 0x1b, 0xf0, 0x1b, 0x26, 0x3b, 0x2e, 0x4a, 0x4b, 0x06,
+    0x60, 0x24, 0xb5, 0x83, 0x82, 0x4b, 0xf5, 0x37, 0x61, 0x40, 0xd4, 0xad, 0xe0, 0xf3, 0x95, 0xe5,
+    0x82, 0x41, 0x7e, 0xab, 0xb3, 0x58, 0x63, 0x89, 0x8c, 0xf2, 0xcb, 0x9c, 0x50, 0x1f, 0xc7, 0x60,
+    0x58, 0x76, 0x36, 0x99, 0xcf, 0xac, 0xaa, 0x12, 0xf3, 0xe9, 0x78, 0x0c, 0xbb, 0xed, 0xd1, 0xf0,
+    0x95, 0x42, 0xfa, 0x18, 0x04, 0x79, 0x02, 0x1a, 0xc6, 0x4b, 0x84, 0xe7, 0x9c, 0x00, 0x2f, 0xc5,
+    0xd1, 0x09, 0x40, 0x6d, 0x22, 0xde, 0xc1, 0x1d, 0x8f, 0x13, 0xb4, 0xe3, 0x59, 0x67, 0x7a, 0x1e,
+    0x4a, 0x6f, 0x8d, 0xdf, 0x1d, 0xfa, 0x5c, 0x4c, 0xe4, 0x6f, 0x85, 0x35, 0xe0, 0x46, 0x6a, 0x84,
+    0xca, 0x56, 0x78, 0x49, 0x4c, 0x93, 0x80, 0xdf, 0x2b, 0x30, 0x51, 0x23, 0x0a, 0x1d, 0xba, 0xaa,
+    0x12, 0x10, 0x8c, 0xfb, 0x29, 0xab, 0x67, 0xbb, 0xd0, 0xdd, 0xe0, 0xcb, 0x34, 0xa5, 0x7b, 0xa5,
+    0x86, 0x97, 0x8d, 0x57, 0x51, 0xbc, 0x97, 0x0f, 0x6c, 0x00, 0x52, 0xba, 0xbf, 0x65, 0x11, 0xd4,
+    0xfb, 0x49, 0xfa, 0x12, 0x66, 0xba, 0xc3, 0xea, 0x5b, 0x32, 0xdd, 0xbe, 0x76, 0x3c, 0xed, 0x31,
+    0x08, 0x8b, 0x6c, 0x1c, 0x8f, 0x42, 0xef, 0xde, 0x92, 0x34, 0xda, 0x3a, 0x1f, 0x25, 0x6b, 0x22,
+    0x7c, 0x79, 0x66, 0x3e, 0xf0, 0x01, 0x22, 0xec, 0xb5, 0xa2, 0xf5, 0x36, 0xd0, 0x12, 0xd9, 0x9f,
+    0xc5, 0xd7, 0x3f, 0xdd, 0xbd, 0x59, 0x5c, 0x18, 0xc6, 0x31, 0x05, 0xf9, 0xf3, 0xfd, 0xe1, 0x0d,
+    0x97, 0xd1, 0x61, 0x5f, 0x68, 0x2a, 0x86, 0xf5, 0x62, 0xe7, 0x99, 0xc2, 0xe4, 0x0f, 0xbd, 0x80,
+    0xaf, 0xda, 0x85, 0x80, 0xe5, 0x86, 0x87, 0x87, 0xa0, 0xb6, 0xba, 0xc0, 0xc6, 0x5f, 0x15, 0xcc,
+    0x42, 0xa0, 0x31, 0xf9, 0x5b, 0xb1, 0x83, 0x4f, 0x7f, 0x43, 0xba, 0xf2, 0x9a, 0x88, 0x6f, 0x82,
+    0x70, 0xcb, 0x6f, 0x90, 0xf4, 0xb1, 0x20, 0x78, 0x4e, 0x2a, 0x22, 0x40, 0x34, 0xc6, 0x9f, 0x27,
+    0x1b, 0x8f, 0xf5, 0x37, 0x67, 0x2d, 0x2c, 0x6e, 0x66, 0xae, 0xb7, 0x4b, 0x53, 0x79, 0x77, 0xa6,
+    0xbd, 0x89, 0x5b, 0x35, 0xbd, 0x89, 0xe3, 0x17, 0xd1, 0xb5, 0x07, 0x75, 0x8a, 0x9c, 0x4a, 0x88,
+    0xda, 0xd3, 0x35, 0xf9, 0x78, 0x71, 0x21, 0x87, 0x94, 0x2f, 0xc6, 0x57, 0xcf, 0xfc, 0xe2, 0xea,
+    0x5f, 0x77, 0xe0, 0xdc, 0x29, 0x5f, 0x73, 0x2a, 0x13, 0x06, 0x07, 0xaa, 0x37, 0xec, 0xcf, 0x56,
+    0xb1, 0x26, 0x5d, 0xa9, 0xa7, 0xbb, 0xfc, 0x3b, 0x09, 0x27, 0x02, 0x25, 0x00, 0xfd, 0xd8, 0xac,
+    0x2c, 0x5d, 0xf1, 0x9e, 0x1e, 0x2a, 0x73, 0xf0, 0x7f, 0xb0, 0xeb, 0x39, 0xc9, 0xa9, 0x04, 0x71,
+    0xa4, 0x2a, 0xc8, 0xc7, 0xf6, 0xff, 0x36, 0x2e, 0x00, 0xbe, 0x03, 0x2c, 0x78, 0xf5, 0xfa, 0xe7,
+    0x3f, 0x74, 0x7e, 0xdc, 0x7f, 0xf0, 0xf0, 0x8a, 0xf6, 0x58, 0x9f, 0xdc, 0xca, 0x9d, 0x7a, 0x9f,
+    0x51, 0x19, 0x53, 0x7b, 0x19, 0xf5, 0x6b, 0x8b, 0x8b, 0x17, 0x4f, 0x7d, 0xfc, 0xfb, 0xf2, 0xa4,
+    0xf8, 0x4a, 0xc1, 0xe5, 0x89, 0xfc, 0x27, 0x18, 0x4e, 0xc4, 0x3f, 0x18, 0xff, 0x7f, 0xe4, 0x70,
+    0x04, 0x6a, 0x41, 0x5e, 0x00, 0x00,
+};
+
+const char kIndexHtmlEtag[] = "\"6a0470e4\"";
+const char kIndexHtmlGzipEtag[] = "\"6a0470e4-gz\"";
 }  // namespace
 
 const char* webUiIndexHtml() {
     return kIndexHtml;
 }
+
+size_t webUiIndexHtmlLength() {
+    return sizeof(kIndexHtml) - 1;
+}
+
+const uint8_t* webUiIndexHtmlGzip() {
+    return kIndexHtmlGzip;
+}
+
+size_t webUiIndexHtmlGzipLength() {
+    return sizeof(kIndexHtmlGzip);
+}
+
+const char* webUiIndexHtmlEtag(bool gzip) {
+    return gzip ? kIndexHtmlGzipEtag : kIndexHtmlEtag;
+}
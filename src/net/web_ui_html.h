@@ -1,3 +1,11 @@
 #pragma once
 
+#include <stddef.h>
+#include <stdint.h>
+
+// Generated from web/index.html by tools/gen_web_ui.py (run via `make`).
 const char* webUiIndexHtml();
+size_t webUiIndexHtmlLength();
+const uint8_t* webUiIndexHtmlGzip();
+size_t webUiIndexHtmlGzipLength();
+const char* webUiIndexHtmlEtag(bool gzip);
@@ -62,7 +62,7 @@ void WifiManager::tick(uint32_t now_ms, DeviceState& state) {
     if (!state.wifi_ready && now_ms - last_connect_ms_ > 5000) {
         WiFi.connect();
         last_connect_ms_ = now_ms;
-        state.wifi_reconnect_count += 1;
+        state.metrics.add(MetricId::WifiReconnects);
     }
 }
 
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Writes the padded encoding plus a terminator; returns 0 if `out` is too small.
+inline size_t base64Encode(const uint8_t* data, size_t len, char* out, size_t out_size) {
+    static const char kAlphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    size_t needed = ((len + 2) / 3) * 4;
+    if (out == nullptr || out_size < needed + 1) {
+        return 0;
+    }
+
+    size_t o = 0;
+    for (size_t i = 0; i < len; i += 3) {
+        uint32_t chunk = static_cast<uint32_t>(data[i]) << 16;
+        if (i + 1 < len) {
+            chunk |= static_cast<uint32_t>(data[i + 1]) << 8;
+        }
+        if (i + 2 < len) {
+            chunk |= data[i + 2];
+        }
+        out[o++] = kAlphabet[(chunk >> 18) & 0x3F];
+        out[o++] = kAlphabet[(chunk >> 12) & 0x3F];
+        out[o++] = (i + 1 < len) ? kAlphabet[(chunk >> 6) & 0x3F] : '=';
+        out[o++] = (i + 2 < len) ? kAlphabet[chunk & 0x3F] : '=';
+    }
+    out[o] = '\0';
+    return o;
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// FNV-1a, usable both in constant expressions (e.g. case labels) and at runtime
+// over a length-delimited span. Both forms produce identical values.
+constexpr uint32_t constHash(const char* s, uint32_t h = 2166136261UL) {
+    return (*s == '\0') ? h : constHash(s + 1, (h ^ static_cast<uint8_t>(*s)) * 16777619UL);
+}
+
+inline uint32_t hashSpan(const char* s, size_t len) {
+    uint32_t h = 2166136261UL;
+    for (size_t i = 0; i < len; ++i) {
+        h = (h ^ static_cast<uint8_t>(s[i])) * 16777619UL;
+    }
+    return h;
+}
+
+inline bool spanEquals(const char* s, size_t len, const char* literal) {
+    return strncmp(s, literal, len) == 0 && literal[len] == '\0';
+}
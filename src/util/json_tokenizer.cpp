@@ -0,0 +1,224 @@
+#include "json_tokenizer.h"
+
+#include <string.h>
+
+namespace {
+const uint8_t kMaxDepth = 4;
+
+class Tokenizer {
+public:
+    Tokenizer(const char* json, size_t len, JsonToken* tokens, size_t max_tokens)
+        : json_(json), len_(len), pos_(0), tokens_(tokens), max_tokens_(max_tokens), count_(0) {}
+
+    int run() {
+        skipSpace();
+        if (!parseValue(0)) {
+            return -1;
+        }
+        skipSpace();
+        return (pos_ == len_) ? static_cast<int>(count_) : -1;
+    }
+
+private:
+    void skipSpace() {
+        while (pos_ < len_ && (json_[pos_] == ' ' || json_[pos_] == '\t' || json_[pos_] == '\r' ||
+                               json_[pos_] == '\n')) {
+            ++pos_;
+        }
+    }
+
+    JsonToken* add(JsonTokenType type, size_t start) {
+        if (count_ >= max_tokens_ || start > 0xFFFF) {
+            return nullptr;
+        }
+        JsonToken* token = &tokens_[count_++];
+        token->type = type;
+        token->start = static_cast<uint16_t>(start);
+        token->end = static_cast<uint16_t>(start);
+        token->size = 0;
+        return token;
+    }
+
+    bool parseValue(uint8_t depth) {
+        if (pos_ >= len_) {
+            return false;
+        }
+        char c = json_[pos_];
+        if (c == '{' || c == '[') {
+            return (depth < kMaxDepth) && parseContainer(depth);
+        }
+        if (c == '"') {
+            return parseString();
+        }
+        return parsePrimitive();
+    }
+
+    bool parseContainer(uint8_t depth) {
+        bool is_object = (json_[pos_] == '{');
+        char close = is_object ? '}' : ']';
+        size_t index = count_;
+        if (add(is_object ? JsonTokenType::Object : JsonTokenType::Array, pos_) == nullptr) {
+            return false;
+        }
+        ++pos_;
+        skipSpace();
+        uint16_t children = 0;
+        if (pos_ < len_ && json_[pos_] == close) {
+            ++pos_;
+        } else {
+            while (true) {
+                if (is_object) {
+                    size_t key = count_;
+                    if (pos_ >= len_ || json_[pos_] != '"' || !parseString()) {
+                        return false;
+                    }
+                    tokens_[key].size = 1;
+                    skipSpace();
+                    if (pos_ >= len_ || json_[pos_] != ':') {
+                        return false;
+                    }
+                    ++pos_;
+                    skipSpace();
+                }
+                if (!parseValue(static_cast<uint8_t>(depth + 1))) {
+                    return false;
+                }
+                ++children;
+                skipSpace();
+                if (pos_ >= len_) {
+                    return false;
+                }
+                if (json_[pos_] == close) {
+                    ++pos_;
+                    break;
+                }
+                if (json_[pos_] != ',') {
+                    return false;
+                }
+                ++pos_;
+                skipSpace();
+            }
+        }
+        // Looked up by index: the pointer from add() is not kept across children.
+        tokens_[index].size = children;
+        tokens_[index].end = static_cast<uint16_t>(pos_);
+        return true;
+    }
+
+    bool parseString() {
+        ++pos_;
+        JsonToken* token = add(JsonTokenType::String, pos_);
+        if (token == nullptr) {
+            return false;
+        }
+        while (pos_ < len_) {
+            char c = json_[pos_];
+            if (c == '"') {
+                token->end = static_cast<uint16_t>(pos_);
+                ++pos_;
+                return true;
+            }
+            if (static_cast<unsigned char>(c) < 0x20) {
+                return false;
+            }
+            if (c == '\\') {
+                ++pos_;
+                // strchr() also matches the terminator, so a NUL is ruled out first.
+                if (pos_ >= len_ || json_[pos_] == '\0' || strchr("\"\\/bfnrtu", json_[pos_]) == nullptr) {
+                    return false;
+                }
+            }
+            ++pos_;
+        }
+        return false;
+    }
+
+    bool parsePrimitive() {
+        size_t start = pos_;
+        while (pos_ < len_ && json_[pos_] != '\0' && strchr("0123456789+-.eEtrufalsn", json_[pos_]) != nullptr) {
+            ++pos_;
+        }
+        if (pos_ == start) {
+            return false;
+        }
+        size_t len = pos_ - start;
+        const char* text = json_ + start;
+        bool keyword = (len == 4 && (strncmp(text, "true", 4) == 0 || strncmp(text, "null", 4) == 0)) ||
+                       (len == 5 && strncmp(text, "false", 5) == 0);
+        char first = text[0];
+        if (!keyword && first != '-' && (first < '0' || first > '9')) {
+            return false;
+        }
+        JsonToken* token = add(JsonTokenType::Primitive, start);
+        if (token == nullptr) {
+            return false;
+        }
+        token->end = static_cast<uint16_t>(pos_);
+        return true;
+    }
+
+    const char* json_;
+    size_t len_;
+    size_t pos_;
+    JsonToken* tokens_;
+    size_t max_tokens_;
+    size_t count_;
+};
+}  // namespace
+
+int jsonTokenize(const char* json, size_t len, JsonToken* tokens, size_t max_tokens) {
+    if (json == nullptr || tokens == nullptr || max_tokens == 0) {
+        return -1;
+    }
+    Tokenizer tokenizer(json, len, tokens, max_tokens);
+    return tokenizer.run();
+}
+
+int jsonSkip(const JsonToken* tokens, int count, int index) {
+    int remaining = 1;
+    while (remaining > 0 && index < count) {
+        remaining += tokens[index].size;
+        --remaining;
+        ++index;
+    }
+    return index;
+}
+
+bool jsonTokenEquals(const char* json, const JsonToken& token, const char* literal) {
+    size_t len = static_cast<size_t>(token.end - token.start);
+    return token.type == JsonTokenType::String && strncmp(json + token.start, literal, len) == 0 &&
+           literal[len] == '\0';
+}
+
+bool jsonTokenToInt(const char* json, const JsonToken& token, int min_v, int max_v, int& out) {
+    if (token.type != JsonTokenType::Primitive) {
+        return false;
+    }
+    const char* p = json + token.start;
+    const char* end = json + token.end;
+    bool negative = (p < end && *p == '-');
+    if (negative) {
+        ++p;
+    }
+    if (p == end) {
+        return false;
+    }
+    long value = 0;
+    for (; p < end; ++p) {
+        if (*p < '0' || *p > '9') {
+            return false;
+        }
+        value = value * 10 + (*p - '0');
+        if (value > 100000L) {
+            return false;
+        }
+    }
+    if (negative) {
+        value = -value;
+    }
+    if (value < min_v || value > max_v) {
+        return false;
+    }
+    out = static_cast<int>(value);
+    return true;
+}
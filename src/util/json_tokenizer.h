@@ -0,0 +1,32 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+enum class JsonTokenType : uint8_t {
+    Object,
+    Array,
+    String,
+    Primitive,
+};
+
+// A span of the input; nothing is copied or unescaped. `size` is the number of
+// direct children (keys for an object, elements for an array, 1 for a key).
+// String spans exclude the quotes.
+struct JsonToken {
+    JsonTokenType type;
+    uint16_t start;
+    uint16_t end;
+    uint16_t size;
+};
+
+// Tokenizes one JSON value into caller-provided storage, depth first, with no
+// allocation. Returns the token count, or -1 for malformed input, trailing
+// garbage, nesting deeper than 4 levels or more tokens than `max_tokens`.
+int jsonTokenize(const char* json, size_t len, JsonToken* tokens, size_t max_tokens);
+
+// Index just past the token at `index` and everything nested inside it.
+int jsonSkip(const JsonToken* tokens, int count, int index);
+
+bool jsonTokenEquals(const char* json, const JsonToken& token, const char* literal);
+bool jsonTokenToInt(const char* json, const JsonToken& token, int min_v, int max_v, int& out);
@@ -0,0 +1,209 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+enum class JsonValueType : uint8_t {
+    Int,
+    UInt,
+    Bool,
+    String,
+};
+
+struct JsonValue {
+    JsonValueType type;
+    union {
+        int32_t i;
+        uint32_t u;
+        bool b;
+        const char* s;
+    };
+};
+
+inline JsonValue jsonInt(int32_t v) {
+    JsonValue value;
+    value.type = JsonValueType::Int;
+    value.i = v;
+    return value;
+}
+
+inline JsonValue jsonUInt(uint32_t v) {
+    JsonValue value;
+    value.type = JsonValueType::UInt;
+    value.u = v;
+    return value;
+}
+
+inline JsonValue jsonBool(bool v) {
+    JsonValue value;
+    value.type = JsonValueType::Bool;
+    value.b = v;
+    return value;
+}
+
+inline JsonValue jsonString(const char* v) {
+    JsonValue value;
+    value.type = JsonValueType::String;
+    value.s = v;
+    return value;
+}
+
+// One member of a flat JSON object: the key and how to read its value from `Source`.
+template <typename Source>
+struct JsonField {
+    const char* name;
+    JsonValue (*read)(const Source& source);
+};
+
+// Sink that only measures, so a response can announce Content-Length before
+// the same content is streamed for real.
+class CountingSink {
+public:
+    void write(const char* data, size_t len) {
+        (void) data;
+        count_ += len;
+    }
+    size_t count() const {
+        return count_;
+    }
+
+private:
+    size_t count_ = 0;
+};
+
+// Sink over a caller-owned buffer for payloads that must be contiguous (MQTT).
+// Output past the end is dropped and reported by overflowed().
+class BufferSink {
+public:
+    BufferSink(char* buffer, size_t size) : buffer_(buffer), size_(size) {}
+
+    void write(const char* data, size_t len) {
+        if (len > size_ - length_) {
+            overflowed_ = true;
+            len = size_ - length_;
+        }
+        for (size_t i = 0; i < len; ++i) {
+            buffer_[length_ + i] = data[i];
+        }
+        length_ += len;
+    }
+    size_t length() const {
+        return length_;
+    }
+    bool overflowed() const {
+        return overflowed_;
+    }
+
+private:
+    char* buffer_;
+    size_t size_;
+    size_t length_ = 0;
+    bool overflowed_ = false;
+};
+
+// Streams a flat JSON object straight into `Sink` (anything with write(const char*, size_t)).
+// Output is built only from descriptors, so braces, commas and string escaping are
+// always balanced; nothing is formatted into an intermediate buffer.
+template <typename Sink>
+class JsonWriter {
+public:
+    explicit JsonWriter(Sink& sink) : sink_(sink) {}
+
+    template <typename Source, size_t N>
+    void writeObject(const JsonField<Source> (&fields)[N], const Source& source) {
+        beginObject();
+        for (size_t i = 0; i < N; ++i) {
+            member(fields[i].name, fields[i].read(source));
+        }
+        endObject();
+    }
+
+    // Incremental form for objects whose members are only known at runtime.
+    void beginObject() {
+        put('{');
+        first_member_ = true;
+    }
+    void member(const char* name, const JsonValue& value) {
+        if (!first_member_) {
+            put(',');
+        }
+        first_member_ = false;
+        writeString(name);
+        put(':');
+        writeValue(value);
+    }
+    void endObject() {
+        put('}');
+    }
+
+private:
+    void put(char c) {
+        sink_.write(&c, 1);
+    }
+
+    void writeValue(const JsonValue& value) {
+        switch (value.type) {
+            case JsonValueType::Int:
+                if (value.i < 0) {
+                    put('-');
+                    writeUnsigned(0U - static_cast<uint32_t>(value.i));
+                } else {
+                    writeUnsigned(static_cast<uint32_t>(value.i));
+                }
+                break;
+            case JsonValueType::UInt:
+                writeUnsigned(value.u);
+                break;
+            case JsonValueType::Bool:
+                // Booleans are emitted as 0/1, matching the rest of the v2 API.
+                put(value.b ? '1' : '0');
+                break;
+            case JsonValueType::String:
+                writeString(value.s);
+                break;
+        }
+    }
+
+    void writeUnsigned(uint32_t v) {
+        char digits[10];
+        size_t pos = sizeof(digits);
+        do {
+            digits[--pos] = static_cast<char>('0' + (v % 10));
+            v /= 10;
+        } while (v != 0);
+        sink_.write(digits + pos, sizeof(digits) - pos);
+    }
+
+    // Runs of plain characters go out in one write; only quotes, backslashes and
+    // control characters are broken out and escaped.
+    void writeString(const char* s) {
+        static const char kHex[] = "0123456789abcdef";
+        put('"');
+        const char* run = (s == nullptr) ? "" : s;
+        const char* p = run;
+        for (; *p != '\0'; ++p) {
+            unsigned char c = static_cast<unsigned char>(*p);
+            if (c >= 0x20 && c != '"' && c != '\\') {
+                continue;
+            }
+            if (p > run) {
+                sink_.write(run, static_cast<size_t>(p - run));
+            }
+            if (c == '"' || c == '\\') {
+                char escaped[2] = {'\\', static_cast<char>(c)};
+                sink_.write(escaped, sizeof(escaped));
+            } else {
+                char escaped[6] = {'\\', 'u', '0', '0', kHex[c >> 4], kHex[c & 0x0F]};
+                sink_.write(escaped, sizeof(escaped));
+            }
+            run = p + 1;
+        }
+        if (p > run) {
+            sink_.write(run, static_cast<size_t>(p - run));
+        }
+        put('"');
+    }
+
+    Sink& sink_;
+    bool first_member_ = true;
+};
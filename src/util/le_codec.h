@@ -0,0 +1,52 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Bounded little-endian writer; independent of host byte order. Writes past
+// the end are dropped and flagged instead of overrunning the buffer.
+class LeWriter {
+public:
+    LeWriter(uint8_t* buf, size_t size) : buf_(buf), size_(size), pos_(0), overflow_(false) {}
+
+    void u8(uint8_t v) {
+        if (pos_ + 1 > size_) {
+            overflow_ = true;
+            return;
+        }
+        buf_[pos_++] = v;
+    }
+
+    void u16(uint16_t v) {
+        u8(static_cast<uint8_t>(v));
+        u8(static_cast<uint8_t>(v >> 8));
+    }
+
+    void u32(uint32_t v) {
+        u16(static_cast<uint16_t>(v));
+        u16(static_cast<uint16_t>(v >> 16));
+    }
+
+    // Overwrites an already written u16, e.g. a length field once the payload is known.
+    void patchU16(size_t offset, uint16_t v) {
+        if (offset + 2 > pos_) {
+            return;
+        }
+        buf_[offset] = static_cast<uint8_t>(v);
+        buf_[offset + 1] = static_cast<uint8_t>(v >> 8);
+    }
+
+    size_t length() const {
+        return pos_;
+    }
+
+    bool overflow() const {
+        return overflow_;
+    }
+
+private:
+    uint8_t* buf_;
+    size_t size_;
+    size_t pos_;
+    bool overflow_;
+};
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Fixed-capacity history ring addressed by a monotonically increasing sample
+// sequence number, so readers can tell which samples are new since last look.
+template <typename T, size_t N>
+class SampleRing {
+public:
+    SampleRing() : total_(0) {
+        clear();
+    }
+
+    void clear() {
+        for (size_t i = 0; i < N; ++i) {
+            data_[i] = T();
+        }
+        total_ = 0;
+    }
+
+    void push(T value) {
+        data_[total_ % N] = value;
+        total_ += 1;
+    }
+
+    // Only the last size() sequence numbers are still held in the ring.
+    T at(uint32_t seq) const {
+        return data_[seq % N];
+    }
+
+    uint32_t total() const {
+        return total_;
+    }
+
+    size_t size() const {
+        return (total_ < N) ? static_cast<size_t>(total_) : N;
+    }
+
+    static size_t capacity() {
+        return N;
+    }
+
+private:
+    T data_[N];
+    uint32_t total_;
+};
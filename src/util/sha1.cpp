@@ -0,0 +1,97 @@
+#include "sha1.h"
+
+#include <string.h>
+
+namespace {
+uint32_t rotl(uint32_t v, int bits) {
+    return (v << bits) | (v >> (32 - bits));
+}
+
+void sha1_block(Sha1Context& ctx, const uint8_t* p) {
+    uint32_t w[80];
+    for (int i = 0; i < 16; ++i) {
+        w[i] = (static_cast<uint32_t>(p[i * 4]) << 24) | (static_cast<uint32_t>(p[i * 4 + 1]) << 16) |
+               (static_cast<uint32_t>(p[i * 4 + 2]) << 8) | static_cast<uint32_t>(p[i * 4 + 3]);
+    }
+    for (int i = 16; i < 80; ++i) {
+        w[i] = rotl(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+    }
+
+    uint32_t a = ctx.state[0];
+    uint32_t b = ctx.state[1];
+    uint32_t c = ctx.state[2];
+    uint32_t d = ctx.state[3];
+    uint32_t e = ctx.state[4];
+    for (int i = 0; i < 80; ++i) {
+        uint32_t f;
+        uint32_t k;
+        if (i < 20) {
+            f = (b & c) | (~b & d);
+            k = 0x5A827999U;
+        } else if (i < 40) {
+            f = b ^ c ^ d;
+            k = 0x6ED9EBA1U;
+        } else if (i < 60) {
+            f = (b & c) | (b & d) | (c & d);
+            k = 0x8F1BBCDCU;
+        } else {
+            f = b ^ c ^ d;
+            k = 0xCA62C1D6U;
+        }
+        uint32_t t = rotl(a, 5) + f + e + k + w[i];
+        e = d;
+        d = c;
+        c = rotl(b, 30);
+        b = a;
+        a = t;
+    }
+    ctx.state[0] += a;
+    ctx.state[1] += b;
+    ctx.state[2] += c;
+    ctx.state[3] += d;
+    ctx.state[4] += e;
+}
+}  // namespace
+
+void sha1_init(Sha1Context& ctx) {
+    ctx.state[0] = 0x67452301U;
+    ctx.state[1] = 0xEFCDAB89U;
+    ctx.state[2] = 0x98BADCFEU;
+    ctx.state[3] = 0x10325476U;
+    ctx.state[4] = 0xC3D2E1F0U;
+    ctx.length = 0;
+    ctx.block_len = 0;
+}
+
+void sha1_update(Sha1Context& ctx, const uint8_t* data, size_t len) {
+    ctx.length += len;
+    for (size_t i = 0; i < len; ++i) {
+        ctx.block[ctx.block_len++] = data[i];
+        if (ctx.block_len == sizeof(ctx.block)) {
+            sha1_block(ctx, ctx.block);
+            ctx.block_len = 0;
+        }
+    }
+}
+
+void sha1_final(Sha1Context& ctx, uint8_t digest[SHA1_DIGEST_SIZE]) {
+    uint64_t bit_len = ctx.length * 8;
+    uint8_t pad = 0x80;
+    sha1_update(ctx, &pad, 1);
+    pad = 0;
+    while (ctx.block_len != 56) {
+        sha1_update(ctx, &pad, 1);
+    }
+    uint8_t len_be[8];
+    for (int i = 0; i < 8; ++i) {
+        len_be[i] = static_cast<uint8_t>(bit_len >> (56 - 8 * i));
+    }
+    sha1_update(ctx, len_be, sizeof(len_be));
+
+    for (int i = 0; i < 5; ++i) {
+        digest[i * 4] = static_cast<uint8_t>(ctx.state[i] >> 24);
+        digest[i * 4 + 1] = static_cast<uint8_t>(ctx.state[i] >> 16);
+        digest[i * 4 + 2] = static_cast<uint8_t>(ctx.state[i] >> 8);
+        digest[i * 4 + 3] = static_cast<uint8_t>(ctx.state[i]);
+    }
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+static const size_t SHA1_DIGEST_SIZE = 20;
+
+struct Sha1Context {
+    uint32_t state[5];
+    uint64_t length;
+    uint8_t block[64];
+    size_t block_len;
+};
+
+void sha1_init(Sha1Context& ctx);
+void sha1_update(Sha1Context& ctx, const uint8_t* data, size_t len);
+void sha1_final(Sha1Context& ctx, uint8_t digest[SHA1_DIGEST_SIZE]);
@@ -0,0 +1,325 @@
+// Host scenario runner for DisplayDriver. Scripted DeviceState sequences go
+// through the real render path onto the fake ST7789 in shims/; every update's
+// wire cost is printed, and the last frame of each scenario is written as a PPM
+// and compared with the checked-in golden.
+//
+//   display_bench [--out DIR] [--golden DIR] [--update-goldens]
+//
+// PPMs hold the RGB565 values as sent, not as the panel shows them: this
+// panel's colour order turns blue into red and cyan into yellow.
+
+#include "Particle.h"
+
+#include "../../src/core/device_state.h"
+#include "../../src/core/settings_store.h"
+#include "../../src/drivers/display_driver.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+namespace {
+const int kBacklightPin = D6;
+
+struct BenchOptions {
+    std::string out_dir = "build/ppm";
+    std::string golden_dir = "goldens";
+    bool update_goldens = false;
+};
+
+std::vector<uint8_t> encodePpm(const Adafruit_SPITFT& tft) {
+    char header[32];
+    int header_len = snprintf(header, sizeof(header), "P6\n%d %d\n255\n", tft.width(), tft.height());
+    std::vector<uint8_t> out(header, header + header_len);
+    out.reserve(out.size() + static_cast<size_t>(tft.width()) * tft.height() * 3);
+    for (int16_t y = 0; y < tft.height(); ++y) {
+        for (int16_t x = 0; x < tft.width(); ++x) {
+            uint16_t c = tft.hostPixel(x, y);
+            uint8_t r = static_cast<uint8_t>((c >> 11) & 0x1F);
+            uint8_t g = static_cast<uint8_t>((c >> 5) & 0x3F);
+            uint8_t b = static_cast<uint8_t>(c & 0x1F);
+            out.push_back(static_cast<uint8_t>((r << 3) | (r >> 2)));
+            out.push_back(static_cast<uint8_t>((g << 2) | (g >> 4)));
+            out.push_back(static_cast<uint8_t>((b << 3) | (b >> 2)));
+        }
+    }
+    return out;
+}
+
+bool readFile(const std::string& path, std::vector<uint8_t>& out) {
+    FILE* f = fopen(path.c_str(), "rb");
+    if (f == nullptr) {
+        return false;
+    }
+    uint8_t chunk[4096];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0) {
+        out.insert(out.end(), chunk, chunk + n);
+    }
+    fclose(f);
+    return true;
+}
+
+bool writeFile(const std::string& path, const std::vector<uint8_t>& data) {
+    FILE* f = fopen(path.c_str(), "wb");
+    if (f == nullptr) {
+        return false;
+    }
+    bool ok = fwrite(data.data(), 1, data.size(), f) == data.size();
+    return (fclose(f) == 0) && ok;
+}
+
+// One scenario: a fresh driver and state, renders reported one line each.
+class Scenario {
+public:
+    // DisplayDriver keeps its panel private; the fake panel it just built is
+    // the most recently constructed one.
+    explicit Scenario(const char* name)
+        : name_(name), display_(A2, A1, A0, kBacklightPin), panel_(*Adafruit_SPITFT::hostLastConstructed()) {
+        SettingsStore().applyDefaults(settings_);
+        initDeviceState(state_, millis());
+        WiFi.hostSetReady(false);
+        WiFi.hostSetLocalIP(IPAddress(192, 168, 1, 42));
+        display_.init();
+        display_.setScreenLight(true);
+        updates_ = 0;
+        total_bytes_ = 0;
+        max_bytes_ = 0;
+    }
+
+    DeviceState& state() {
+        return state_;
+    }
+
+    void render(const char* step) {
+        DisplayRenderStats before = display_.renderStats();
+        display_.render(state_, settings_);
+        report(step, before);
+    }
+
+    void renderSetup(const char* step, const char* ssid, const char* ip) {
+        DisplayRenderStats before = display_.renderStats();
+        display_.renderSetupScreen(ssid, ip);
+        report(step, before);
+    }
+
+    // One PM history sample, as AppController records them every 30 s.
+    void pushHistory(uint16_t pm25) {
+        hostAdvanceMillis(kPmHistoryIntervalMs);
+        state_.pm25_history.push(pm25);
+    }
+
+    void summarize() const {
+        printf("%-11s %u updates, %u bytes total, %u mean, %u max\n\n",
+               name_,
+               static_cast<unsigned>(updates_),
+               static_cast<unsigned>(total_bytes_),
+               static_cast<unsigned>(updates_ > 0 ? total_bytes_ / updates_ : 0),
+               static_cast<unsigned>(max_bytes_));
+    }
+
+    // Writes the current frame and compares it with the golden of the same name.
+    bool checkGolden(const BenchOptions& options) const;
+
+private:
+    void report(const char* step, const DisplayRenderStats& before) {
+        const DisplayRenderStats& after = display_.renderStats();
+        uint32_t bytes = after.total_bytes - before.total_bytes;
+        uint32_t windows = 0;
+        uint32_t pixels = 0;
+        if (after.updates != before.updates) {
+            windows = after.last_update_windows;
+            pixels = after.last_update_pixels;
+            updates_ += 1;
+        }
+        total_bytes_ += bytes;
+        if (bytes > max_bytes_) {
+            max_bytes_ = bytes;
+        }
+        printf("%-11s %-28s %8u %8u %8u\n",
+               name_,
+               step,
+               static_cast<unsigned>(windows),
+               static_cast<unsigned>(pixels),
+               static_cast<unsigned>(bytes));
+    }
+
+    const char* name_;
+    SettingsV2 settings_;
+    DeviceState state_;
+    DisplayDriver display_;
+    const Adafruit_SPITFT& panel_;
+    uint32_t updates_;
+    uint32_t total_bytes_;
+    uint32_t max_bytes_;
+};
+
+bool Scenario::checkGolden(const BenchOptions& options) const {
+    std::vector<uint8_t> frame = encodePpm(panel_);
+    std::string file = std::string(name_) + ".ppm";
+    std::string golden_path = options.golden_dir + "/" + file;
+
+    if (!writeFile(options.out_dir + "/" + file, frame)) {
+        printf("golden %-18s cannot write %s/%s\n", file.c_str(), options.out_dir.c_str(), file.c_str());
+        return false;
+    }
+    if (options.update_goldens) {
+        bool ok = writeFile(golden_path, frame);
+        printf("golden %-18s %s\n", file.c_str(), ok ? "updated" : "write failed");
+        return ok;
+    }
+
+    std::vector<uint8_t> golden;
+    if (!readFile(golden_path, golden)) {
+        printf("golden %-18s missing (run with --update-goldens)\n", file.c_str());
+        return false;
+    }
+    if (golden.size() != frame.size()) {
+        printf("golden %-18s size differs: %zu vs %zu bytes\n", file.c_str(), frame.size(), golden.size());
+        return false;
+    }
+    size_t differing = 0;
+    for (size_t i = 0; i < frame.size(); i += 3) {
+        if (memcmp(&frame[i], &golden[i], 3) != 0) {
+            differing += 1;
+        }
+    }
+    if (differing > 0) {
+        printf("golden %-18s %zu pixels differ\n", file.c_str(), differing);
+        return false;
+    }
+    printf("golden %-18s ok\n", file.c_str());
+    return true;
+}
+
+bool runBoot(const BenchOptions& options) {
+    Scenario s("boot");
+    s.render("first frame, wifi joining");
+    s.render("no change");
+    s.summarize();
+    return s.checkGolden(options);
+}
+
+bool runFanSweep(const BenchOptions& options) {
+    Scenario s("fan_sweep");
+    DeviceState& state = s.state();
+    state.wifi_ready = true;
+    state.wifi_ip_visible = true;
+    WiFi.hostSetReady(true);
+    state.pm25_smooth = 8;
+    state.pm10_smooth = 12;
+    s.render("first frame");
+
+    char step[32];
+    for (int percent = 0; percent <= 100; percent += 10) {
+        state.fan_percent = percent;
+        snprintf(step, sizeof(step), "fan %d%%", percent);
+        s.render(step);
+    }
+    for (int percent = 75; percent >= 0; percent -= 25) {
+        state.fan_percent = percent;
+        snprintf(step, sizeof(step), "fan %d%%", percent);
+        s.render(step);
+    }
+    state.fan_percent = 40;
+    s.render("fan 40%");
+    s.summarize();
+    return s.checkGolden(options);
+}
+
+bool runPmChanges(const BenchOptions& options) {
+    Scenario s("pm_changes");
+    DeviceState& state = s.state();
+    state.wifi_ready = true;
+    WiFi.hostSetReady(true);
+    state.fan_percent = 40;
+    s.render("first frame");
+
+    // pm2.5 / pm10 in ug/m3, spanning every history colour band.
+    static const uint16_t kReadings[][2] = {
+        {5, 8}, {6, 8}, {12, 19}, {13, 21}, {36, 54}, {88, 120}, {150, 211}, {40, 60}, {9, 14}, {9, 15},
+    };
+    char step[32];
+    for (size_t i = 0; i < sizeof(kReadings) / sizeof(kReadings[0]); ++i) {
+        state.pm25_smooth = kReadings[i][0];
+        state.pm10_smooth = kReadings[i][1];
+        snprintf(step, sizeof(step), "pm %u/%u", kReadings[i][0], kReadings[i][1]);
+        s.render(step);
+        s.pushHistory(kReadings[i][0]);
+        snprintf(step, sizeof(step), "history sample %u", static_cast<unsigned>(i + 1));
+        s.render(step);
+    }
+    // A long gap: more new samples than the strip shows forces a full redraw.
+    for (uint16_t i = 0; i < 200; ++i) {
+        s.pushHistory(static_cast<uint16_t>((i * 7) % 110));
+    }
+    s.render("history catch-up (200)");
+    s.summarize();
+    return s.checkGolden(options);
+}
+
+bool runWifiFlap(const BenchOptions& options) {
+    Scenario s("wifi_flap");
+    DeviceState& state = s.state();
+    state.fan_percent = 60;
+    state.pm25_smooth = 14;
+    state.pm10_smooth = 22;
+    state.wifi_ip_visible = true;
+    s.render("first frame, joining");
+
+    for (int round = 1; round <= 3; ++round) {
+        char step[32];
+        state.wifi_ready = true;
+        WiFi.hostSetReady(true);
+        snprintf(step, sizeof(step), "round %d: connected", round);
+        s.render(step);
+        state.wifi_ready = false;
+        WiFi.hostSetReady(false);
+        snprintf(step, sizeof(step), "round %d: link lost", round);
+        s.render(step);
+    }
+    state.wifi_enabled = false;
+    s.render("wifi switched off");
+    state.wifi_enabled = true;
+    state.wifi_ready = true;
+    WiFi.hostSetReady(true);
+    s.render("wifi back on, connected");
+    s.summarize();
+    return s.checkGolden(options);
+}
+
+bool runSetup(const BenchOptions& options) {
+    Scenario s("setup");
+    s.renderSetup("setup screen", "Aeris-1A2B", "192.168.0.1");
+    s.renderSetup("same setup screen", "Aeris-1A2B", "192.168.0.1");
+    s.summarize();
+    return s.checkGolden(options);
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            options.out_dir = argv[++i];
+        } else if (strcmp(argv[i], "--golden") == 0 && i + 1 < argc) {
+            options.golden_dir = argv[++i];
+        } else if (strcmp(argv[i], "--update-goldens") == 0) {
+            options.update_goldens = true;
+        } else {
+            fprintf(stderr, "usage: %s [--out DIR] [--golden DIR] [--update-goldens]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    printf("%-11s %-28s %8s %8s %8s\n", "scenario", "step", "windows", "pixels", "bytes");
+    bool ok = true;
+    ok = runBoot(options) && ok;
+    ok = runFanSweep(options) && ok;
+    ok = runPmChanges(options) && ok;
+    ok = runWifiFlap(options) && ok;
+    ok = runSetup(options) && ok;
+    return ok ? 0 : 1;
+}
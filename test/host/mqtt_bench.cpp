@@ -0,0 +1,582 @@
+// Host scenario runner for MqttClient. The real client and its connect worker
+// run against the scripted in-memory broker in shims/fake_broker.h on a 5 ms
+// loop tick, and each scenario reports what the broker received: messages/s,
+// end-to-end latency from publishValue() to delivery past the send window,
+// values that never arrived (overwritten before sending, or lost with a
+// dropped session), publishes the window refused, and command ingest rate.
+//
+//   mqtt_bench
+//
+// Every topic is fed strictly increasing values with its deadband and the
+// heartbeat turned off, so each delivered value identifies the update it came
+// from. Exits non-zero when a scenario's checks fail.
+
+#include "Particle.h"
+#include "fake_broker.h"
+
+#include "../../src/core/device_state.h"
+#include "../../src/core/settings_store.h"
+#include "../../src/net/mqtt_client.h"
+#include "../../src/util/string_safety.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace {
+const uint32_t kTickMs = 5;
+const uint32_t kConnectDeadlineMs = 5000;
+const char kTopicRoot[] = "aeris/bench";
+// All 13 topics at once drain through the default bucket (8, then 40/s) in
+// about 125 ms.
+const uint32_t kPacedRoundMs = 150;
+
+// MqttTopic order; the group prefix doubles as the aggregate topic.
+const struct {
+    const char* group;
+    const char* name;
+} kTopics[] = {
+    {"state", "fan_percent"},
+    {"state", "fan_pwm"},
+    {"state", "lights"},
+    {"sensor", "pm25"},
+    {"sensor", "pm10"},
+    {"health", "uptime_s"},
+    {"health", "wifi_reconnect_count"},
+    {"health", "mqtt_reconnect_count"},
+    {"health", "sensor_parse_errors"},
+    {"health", "command_drop_button_count"},
+    {"health", "command_drop_mqtt_count"},
+    {"health", "command_drop_web_count"},
+    {"health", "mqtt_publish_drop_count"},
+};
+const uint8_t kTopicCount = static_cast<uint8_t>(MqttTopic::Count);
+static_assert(sizeof(kTopics) / sizeof(kTopics[0]) == kTopicCount, "bench topic table out of sync");
+const uint8_t kFirstHealthTopic = static_cast<uint8_t>(MqttTopic::HealthUptime);
+
+uint32_t percentile(std::vector<uint32_t> values, uint32_t pct) {
+    if (values.empty()) {
+        return 0;
+    }
+    std::sort(values.begin(), values.end());
+    return values[(values.size() - 1) * pct / 100];
+}
+
+bool countCommand(const Command& cmd, void* ctx) {
+    *static_cast<uint32_t*>(ctx) += 1;
+    return true;
+}
+
+// One scenario: a freshly reset broker, a new client and DeviceState, and the
+// bookkeeping that matches deliveries back to the updates that caused them.
+// Clients are never destroyed: their connect worker keeps running, as it
+// does on the device.
+class Bench {
+public:
+    Bench(const char* name, MqttPublishMode mode) : name_(name), client_(*new MqttClient()) {
+        hostBroker().reset();
+        WiFi.hostSetReady(true);
+        WiFi.hostSetResolveResult(IPAddress(192, 168, 1, 10));
+
+        initDeviceState(state_, millis());
+        state_.wifi_ready = true;
+
+        SettingsV2 settings;
+        SettingsStore().applyDefaults(settings);
+        settings.mqtt_enabled = 1;
+        settings.mqtt_publish_mode = static_cast<uint8_t>(mode);
+        safeCopy(settings.mqtt_host, sizeof(settings.mqtt_host), "broker.lan");
+        safeCopy(settings.mqtt_topic_root, sizeof(settings.mqtt_topic_root), kTopicRoot);
+
+        client_.setMetrics(&state_.metrics);
+        client_.setCommandSink(countCommand, &commands_accepted_);
+        client_.setHeartbeatInterval(0);
+        for (uint8_t i = 0; i < kTopicCount; ++i) {
+            client_.setDeadband(static_cast<MqttTopic>(i), 0, 0);
+        }
+        client_.configure(settings);
+        for (uint8_t i = 0; i < kTopicCount; ++i) {
+            next_value_[i] = 1;
+        }
+    }
+
+    DeviceState& state() {
+        return state_;
+    }
+    FakeBroker& broker() const {
+        return hostBroker();
+    }
+
+    // Feeds the next value of `topic` to the client.
+    void update(uint8_t topic) {
+        int32_t value = next_value_[topic]++;
+        pending_[topic].push_back(Pending{value, millis()});
+        client_.publishValue(static_cast<MqttTopic>(topic), value, millis());
+        offered_ += 1;
+    }
+    void updateAll() {
+        for (uint8_t i = 0; i < kTopicCount; ++i) {
+            update(i);
+        }
+    }
+
+    void tick() {
+        // Captures only happen offline and replay only online, so within one
+        // tick the backlog moves one way.
+        uint32_t backlog = state_.metrics.get(MetricId::MqttOfflineBacklog);
+        client_.tick(millis(), state_);
+        uint32_t after = state_.metrics.get(MetricId::MqttOfflineBacklog);
+        offline_captured_ += (after > backlog) ? after - backlog : 0;
+        collect();
+        hostAdvanceMillis(kTickMs);
+    }
+    void run(uint32_t ms) {
+        for (uint32_t end = millis() + ms; static_cast<int32_t>(millis() - end) < 0;) {
+            tick();
+        }
+    }
+    bool runUntilConnected(uint32_t deadline_ms) {
+        for (uint32_t end = millis() + deadline_ms; static_cast<int32_t>(millis() - end) < 0;) {
+            tick();
+            if (state_.mqtt_connected) {
+                return true;
+            }
+        }
+        return false;
+    }
+    // Runs until every update fed so far has been delivered or overwritten.
+    bool runUntilSettled(uint32_t deadline_ms) {
+        for (uint32_t end = millis() + deadline_ms; static_cast<int32_t>(millis() - end) < 0;) {
+            tick();
+            if (outstanding() == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Message counters restart here, so the connect and first snapshot are
+    // excluded; offline capture and replay are counted over the whole run.
+    void startMeasuring() {
+        collect();
+        measure_start_ms_ = millis();
+        offered_ = 0;
+        delivered_ = 0;
+        delivered_bytes_ = 0;
+        superseded_ = 0;
+        lost_ = 0;
+        refused_at_start_ = broker().refusedPublishes();
+        publish_calls_at_start_ = state_.metrics.count(HistogramId::MqttPublishCallUs);
+        publish_call_us_at_start_ = state_.metrics.sum(HistogramId::MqttPublishCallUs);
+        latencies_.clear();
+    }
+
+    size_t outstanding() const {
+        size_t n = 0;
+        for (uint8_t i = 0; i < kTopicCount; ++i) {
+            n += pending_[i].size();
+        }
+        return n;
+    }
+    uint32_t offlineCaptured() const {
+        return offline_captured_;
+    }
+    uint32_t historyRows() const {
+        return history_rows_;
+    }
+    uint32_t lost() const {
+        return lost_;
+    }
+    uint32_t superseded() const {
+        return superseded_;
+    }
+    uint32_t refused() const {
+        return broker().refusedPublishes() - refused_at_start_;
+    }
+    uint32_t publishDrops() const {
+        return client_.publishDropCount();
+    }
+    uint32_t commandsAccepted() const {
+        return commands_accepted_;
+    }
+    uint32_t latencyPercentile(uint32_t pct) const {
+        return percentile(latencies_, pct);
+    }
+
+    void report() const {
+        uint32_t elapsed_ms = millis() - measure_start_ms_;
+        uint32_t calls = state_.metrics.count(HistogramId::MqttPublishCallUs) - publish_calls_at_start_;
+        uint32_t call_us = state_.metrics.sum(HistogramId::MqttPublishCallUs) - publish_call_us_at_start_;
+        printf("%-15s %6u %7.1f %8u %6u %6u %6u %6u %6u %6u %6u %6u\n",
+               name_,
+               delivered_,
+               (elapsed_ms == 0) ? 0.0 : delivered_ * 1000.0 / elapsed_ms,
+               delivered_bytes_,
+               offered_,
+               percentile(latencies_, 50),
+               percentile(latencies_, 99),
+               latencies_.empty() ? 0 : *std::max_element(latencies_.begin(), latencies_.end()),
+               superseded_,
+               refused(),
+               lost_,
+               (calls == 0) ? 0 : call_us / calls);
+    }
+
+    bool check(bool ok, const char* what) const {
+        printf("%-15s   check %s: %s\n", name_, what, ok ? "ok" : "FAILED");
+        return ok;
+    }
+
+private:
+    struct Pending {
+        int32_t value;
+        uint32_t set_ms;
+    };
+
+    // Consumes every delivery the broker has completed by now.
+    void collect() {
+        const std::vector<FakeBroker::Delivery>& log = broker().deliveries();
+        while (cursor_ < log.size()) {
+            const FakeBroker::Delivery& d = log[cursor_];
+            if (d.lost) {
+                lost_ += 1;
+                ++cursor_;
+                continue;
+            }
+            if (static_cast<int32_t>(d.delivered_ms - millis()) > 0) {
+                break;
+            }
+            delivered_ += 1;
+            delivered_bytes_ += static_cast<uint32_t>(d.topic.size() + d.payload.size());
+            matchDelivery(d);
+            ++cursor_;
+        }
+    }
+
+    void matchDelivery(const FakeBroker::Delivery& d) {
+        const char* rest = d.topic.c_str() + strlen(kTopicRoot) + 1;
+        if (strcmp(rest, "history") == 0) {
+            // {"clock":...,"samples":[[...],[...]]}: one '[' per row plus the list.
+            history_rows_ += static_cast<uint32_t>(std::count(d.payload.begin(), d.payload.end(), '[')) - 1;
+            return;
+        }
+        for (uint8_t i = 0; i < kTopicCount; ++i) {
+            size_t group_len = strlen(kTopics[i].group);
+            if (strncmp(rest, kTopics[i].group, group_len) != 0) {
+                continue;
+            }
+            if (rest[group_len] == '\0') {
+                // Aggregate document: every member of the group is a delivery.
+                std::string key = std::string("\"") + kTopics[i].name + "\":";
+                size_t at = d.payload.find(key);
+                if (at != std::string::npos) {
+                    matchValue(i, atoi(d.payload.c_str() + at + key.size()), d.delivered_ms);
+                }
+            } else if (rest[group_len] == '/' && strcmp(rest + group_len + 1, kTopics[i].name) == 0) {
+                matchValue(i, atoi(d.payload.c_str()), d.delivered_ms);
+                return;
+            }
+        }
+    }
+
+    // Values are increasing, so everything older than the delivered one was
+    // overwritten before it went out.
+    void matchValue(uint8_t topic, int32_t value, uint32_t delivered_ms) {
+        std::deque<Pending>& pending = pending_[topic];
+        while (!pending.empty() && pending.front().value < value) {
+            pending.pop_front();
+            superseded_ += 1;
+        }
+        if (!pending.empty() && pending.front().value == value) {
+            latencies_.push_back(delivered_ms - pending.front().set_ms);
+            pending.pop_front();
+        }
+    }
+
+    const char* name_;
+    MqttClient& client_;
+    DeviceState state_;
+    uint32_t commands_accepted_ = 0;
+    int32_t next_value_[kTopicCount];
+    std::deque<Pending> pending_[kTopicCount];
+    size_t cursor_ = 0;
+
+    uint32_t measure_start_ms_ = 0;
+    uint32_t offered_ = 0;
+    uint32_t delivered_ = 0;
+    uint32_t delivered_bytes_ = 0;
+    uint32_t superseded_ = 0;
+    uint32_t lost_ = 0;
+    uint32_t history_rows_ = 0;
+    uint32_t offline_captured_ = 0;
+    uint32_t refused_at_start_ = 0;
+    uint32_t publish_calls_at_start_ = 0;
+    uint32_t publish_call_us_at_start_ = 0;
+    std::vector<uint32_t> latencies_;
+};
+
+// A loaded LAN broker: CONNACK in 40 ms, and a socket write costs about 150 us
+// plus 1 us per 10 bytes.
+void configureLanBroker(FakeBroker& broker) {
+    broker.setConnectTiming(40, 2000);
+    broker.setPublishCostUs(150, 100);
+}
+
+// State and sensor values every 250 ms, health every second: 28 updates/s,
+// inside the default pacing of 40/s.
+void runSteadyLoad(Bench& b, uint32_t ms) {
+    for (uint32_t t = 0; t < ms; t += 250) {
+        for (uint8_t i = 0; i < kFirstHealthTopic; ++i) {
+            b.update(i);
+        }
+        if (t % 1000 == 0) {
+            for (uint8_t i = kFirstHealthTopic; i < kTopicCount; ++i) {
+                b.update(i);
+            }
+        }
+        b.run(250);
+    }
+}
+
+bool steadyPerTopic() {
+    Bench b("steady", MqttPublishMode::PerTopic);
+    configureLanBroker(b.broker());
+    bool ok = b.check(b.runUntilConnected(kConnectDeadlineMs), "connects");
+    b.startMeasuring();
+    runSteadyLoad(b, 30000);
+    ok = b.check(b.runUntilSettled(1000), "every update delivered") && ok;
+    b.report();
+    ok = b.check(b.superseded() == 0, "no value overwritten below the pacing limit") && ok;
+    ok = b.check(b.latencyPercentile(50) <= kTickMs, "p50 latency within one tick") && ok;
+    ok = b.check(b.latencyPercentile(99) <= kPacedRoundMs, "p99 latency within one paced round") && ok;
+    return ok;
+}
+
+bool steadyAggregate() {
+    Bench b("aggregate", MqttPublishMode::Aggregate);
+    configureLanBroker(b.broker());
+    bool ok = b.check(b.runUntilConnected(kConnectDeadlineMs), "connects");
+    b.startMeasuring();
+    runSteadyLoad(b, 30000);
+    ok = b.check(b.runUntilSettled(1000), "every update delivered") && ok;
+    b.report();
+    return ok;
+}
+
+// Every 2 s all 13 topics change four times within one tick; only the last
+// value of each should go out, and the 13 sends are paced by the bucket.
+bool burst() {
+    const uint32_t kBursts = 10;
+    const uint32_t kRepeats = 4;
+    Bench b("burst", MqttPublishMode::PerTopic);
+    configureLanBroker(b.broker());
+    bool ok = b.check(b.runUntilConnected(kConnectDeadlineMs), "connects");
+    b.startMeasuring();
+    uint32_t worst_drain_ms = 0;
+    for (uint32_t n = 0; n < kBursts; ++n) {
+        uint32_t start_ms = millis();
+        for (uint32_t r = 0; r < kRepeats; ++r) {
+            b.updateAll();
+        }
+        b.runUntilSettled(2000);
+        worst_drain_ms = std::max(worst_drain_ms, millis() - start_ms);
+        b.run(2000 - (millis() - start_ms));
+    }
+    b.report();
+    printf("%-15s   slowest burst drained in %u ms\n", "burst", worst_drain_ms);
+    ok = b.check(b.outstanding() == 0, "last value of every topic delivered") && ok;
+    ok = b.check(b.superseded() == kBursts * (kRepeats - 1) * kTopicCount, "only overwritten values dropped") && ok;
+    ok = b.check(worst_drain_ms <= 250, "a burst drains within 250 ms") && ok;
+    return ok;
+}
+
+// A broker that ACKs slowly: a 1 KB window draining 800 bytes/s (about 20
+// value messages/s) under the steady load plus a burst every 5 s. Refused
+// publishes back the client off; the latest values must still get through
+// once the load stops.
+bool slowAck() {
+    Bench b("slow_ack", MqttPublishMode::PerTopic);
+    configureLanBroker(b.broker());
+    b.broker().setSendWindow(1024, 800);
+    bool ok = b.check(b.runUntilConnected(kConnectDeadlineMs), "connects");
+    b.startMeasuring();
+    for (uint32_t t = 0; t < 30000; t += 5000) {
+        b.updateAll();
+        runSteadyLoad(b, 5000);
+    }
+    ok = b.check(b.runUntilSettled(10000), "latest values delivered within 10 s of the load stopping") && ok;
+    b.report();
+    ok = b.check(b.refused() > 0, "the window refused publishes") && ok;
+    ok = b.check(b.publishDrops() == b.broker().refusedPublishes(), "every refusal counted as a publish drop") && ok;
+    ok = b.check(b.lost() == 0, "nothing lost without a disconnect") && ok;
+    return ok;
+}
+
+// Inbound commands: 400 queued at the broker at once, a tenth of them on an
+// unknown topic and a fifth with bad payloads, while steady values go out.
+bool commandIngest() {
+    const uint32_t kCommands = 400;
+    Bench b("commands", MqttPublishMode::PerTopic);
+    configureLanBroker(b.broker());
+    bool ok = b.check(b.runUntilConnected(kConnectDeadlineMs), "connects");
+    b.startMeasuring();
+
+    uint32_t valid = 0;
+    uint32_t injected = 0;
+    char topic[64];
+    char payload[16];
+    for (uint32_t i = 0; i < kCommands; ++i) {
+        const char* suffix = "fan_percent";
+        snprintf(payload, sizeof(payload), "%u", i % 101);
+        bool expect_valid = true;
+        switch (i % 10) {
+            case 6:
+                suffix = "lights";
+                snprintf(payload, sizeof(payload), "%s", (i % 20 == 6) ? "on" : "off");
+                break;
+            case 7:
+                suffix = "reboot";
+                snprintf(payload, sizeof(payload), "0");
+                expect_valid = false;
+                break;
+            case 8:
+                snprintf(payload, sizeof(payload), "abc");
+                expect_valid = false;
+                break;
+            case 9:
+                suffix = "unknown";
+                expect_valid = false;
+                break;
+            default:
+                break;
+        }
+        snprintf(topic, sizeof(topic), "%s/cmd/%s", kTopicRoot, suffix);
+        injected += b.broker().inject(topic, payload) ? 1 : 0;
+        valid += expect_valid ? 1 : 0;
+    }
+
+    uint32_t start_ms = millis();
+    for (uint32_t t = 0; t < 10000 && b.broker().pendingInbound() > 0; t += 250) {
+        for (uint8_t i = 0; i < kFirstHealthTopic; ++i) {
+            b.update(i);
+        }
+        for (uint32_t n = 0; n < 250 / kTickMs && b.broker().pendingInbound() > 0; ++n) {
+            b.tick();
+        }
+    }
+    uint32_t elapsed_ms = millis() - start_ms;
+    ok = b.check(b.runUntilSettled(1000), "values still delivered during ingest") && ok;
+    b.report();
+
+    const MetricsRegistry& m = b.state().metrics;
+    printf("%-15s   %u commands ingested in %u ms: %.0f cmd/s; %u accepted, %u rejected\n",
+           "commands",
+           injected,
+           elapsed_ms,
+           (elapsed_ms == 0) ? 0.0 : injected * 1000.0 / elapsed_ms,
+           m.get(MetricId::MqttCommandsReceived),
+           m.get(MetricId::MqttCommandsRejected));
+    ok = b.check(injected == kCommands, "every command routed to the subscription") && ok;
+    ok = b.check(b.commandsAccepted() == valid && m.get(MetricId::MqttCommandsReceived) == valid,
+                 "valid commands reach the sink") &&
+         ok;
+    ok = b.check(m.get(MetricId::MqttCommandsRejected) == kCommands - valid, "invalid commands rejected") && ok;
+    return ok;
+}
+
+// The broker goes away twice, for 20 s and for 90 s, under a light load.
+// Connects to the down broker fail after 2 s. Reports how long the client
+// takes to get back after each outage and checks that the offline samples
+// are replayed in full. The long outage outlasts four failed connects, so the
+// client sits out the 5-minute suspension before it tries again.
+bool brokerFlap() {
+    struct Outage {
+        uint32_t down_at_ms;
+        uint32_t duration_ms;
+    };
+    const Outage kOutages[] = {{20000, 20000}, {60000, 90000}};
+    const uint32_t kRecoveryDeadlineMs = 400000;
+
+    Bench b("broker_flap", MqttPublishMode::PerTopic);
+    configureLanBroker(b.broker());
+    b.broker().setSendWindow(2048, 8000);
+    Time.hostSetUnix(1760000000);
+    bool ok = b.check(b.runUntilConnected(kConnectDeadlineMs), "connects");
+    uint32_t origin_ms = millis();
+    b.startMeasuring();
+
+    for (const Outage& outage : kOutages) {
+        while (millis() - origin_ms < outage.down_at_ms) {
+            b.update(static_cast<uint8_t>(MqttTopic::StateFanPercent));
+            b.update(static_cast<uint8_t>(MqttTopic::SensorPm25));
+            b.run(1000);
+        }
+        uint32_t attempts_before = b.broker().connectAttempts();
+        uint32_t captured_before = b.offlineCaptured();
+        b.broker().setUp(false);
+        uint32_t down_ms = millis();
+        while (millis() - down_ms < outage.duration_ms) {
+            b.update(static_cast<uint8_t>(MqttTopic::StateFanPercent));
+            b.run(1000);
+        }
+        b.broker().setUp(true);
+        uint32_t up_ms = millis();
+        bool recovered = b.runUntilConnected(kRecoveryDeadlineMs);
+        printf("%-15s   outage %u s: back %u ms after the broker, %u connect attempts, %u samples captured\n",
+               "broker_flap",
+               outage.duration_ms / 1000,
+               millis() - up_ms,
+               b.broker().connectAttempts() - attempts_before,
+               b.offlineCaptured() - captured_before);
+        ok = b.check(recovered, "reconnects") && ok;
+    }
+    b.run(10000);
+    ok = b.check(b.runUntilSettled(5000), "latest values delivered after the flaps") && ok;
+    b.report();
+
+    const MetricsRegistry& m = b.state().metrics;
+    printf("%-15s   %u sessions, %u reconnect attempts counted, %u history rows replayed\n",
+           "broker_flap",
+           b.broker().sessionsOpened(),
+           m.get(MetricId::MqttReconnects),
+           b.historyRows());
+    ok = b.check(m.get(MetricId::MqttOfflineBacklog) == 0, "offline backlog drained") && ok;
+    ok = b.check(m.get(MetricId::MqttOfflineDrops) == 0, "no offline sample dropped") && ok;
+    ok = b.check(b.historyRows() == b.offlineCaptured(), "every captured sample replayed") && ok;
+    return ok;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+    printf("%-15s %6s %7s %8s %6s %6s %6s %6s %6s %6s %6s %6s\n",
+           "scenario",
+           "msgs",
+           "msg/s",
+           "bytes",
+           "offer",
+           "p50ms",
+           "p99ms",
+           "maxms",
+           "overwr",
+           "refuse",
+           "lost",
+           "call_us");
+    bool ok = steadyPerTopic();
+    ok = steadyAggregate() && ok;
+    ok = burst() && ok;
+    ok = slowAck() && ok;
+    ok = commandIngest() && ok;
+    ok = brokerFlap() && ok;
+    printf("%s\n", ok ? "all checks passed" : "checks FAILED");
+
+    // The connect workers never return; leave without running destructors
+    // under them.
+    fflush(stdout);
+    _exit(ok ? 0 : 1);
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "Adafruit_ST77xx.h"
+
+class Adafruit_ST7789 : public Adafruit_ST77xx {
+public:
+    Adafruit_ST7789(int8_t cs, int8_t dc, int8_t rst);
+
+    void init(uint16_t width, uint16_t height, uint8_t spi_mode = 0);
+    void setRotation(uint8_t m) override;
+};
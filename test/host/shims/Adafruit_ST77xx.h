@@ -0,0 +1,132 @@
+#pragma once
+
+// Host stand-in for the Adafruit_ST7735_RK GFX stack. Primitives open address
+// windows the way Adafruit_SPITFT does: one per filled rect or fast line, one
+// 1x1 window per pixel of a sloped line or a size-1 glyph. Wire costs counted
+// through setAddrWindow() therefore match the device, and the pixels streamed
+// into each window land in an RGB565 framebuffer instead of the panel.
+//
+// Glyphs are not the library's 5x7 font; each character gets a fixed pattern
+// derived from its code. Text drawn with a background colour costs the same
+// either way. Transparent text only paints set bits, so its cost is close but
+// not exact.
+
+#include "Particle.h"
+
+#include <vector>
+
+#define ST77XX_BLACK 0x0000
+#define ST77XX_WHITE 0xFFFF
+#define ST77XX_RED 0xF800
+#define ST77XX_GREEN 0x07E0
+#define ST77XX_BLUE 0x001F
+#define ST77XX_CYAN 0x07FF
+#define ST77XX_MAGENTA 0xF81F
+#define ST77XX_YELLOW 0xFFE0
+#define ST77XX_ORANGE 0xFC00
+
+#define ST77XX_MADCTL 0x36
+#define ST77XX_MADCTL_MY 0x80
+#define ST77XX_MADCTL_MX 0x40
+#define ST77XX_MADCTL_MV 0x20
+#define ST77XX_MADCTL_RGB 0x00
+
+class Adafruit_GFX : public Print {
+public:
+    Adafruit_GFX(int16_t w, int16_t h);
+
+    virtual void drawPixel(int16_t x, int16_t y, uint16_t color) = 0;
+    virtual void writePixel(int16_t x, int16_t y, uint16_t color);
+    virtual void writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) = 0;
+    virtual void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+    virtual void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+
+    virtual void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+    virtual void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+    virtual void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+    virtual void fillScreen(uint16_t color);
+    virtual void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+    virtual void setRotation(uint8_t r);
+    virtual void invertDisplay(bool i);
+
+    void fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color);
+    void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size);
+
+    void setCursor(int16_t x, int16_t y);
+    void setTextColor(uint16_t c);
+    void setTextColor(uint16_t c, uint16_t bg);
+    void setTextSize(uint8_t s);
+    void setTextWrap(bool w);
+
+    int16_t width() const;
+    int16_t height() const;
+
+    using Print::write;
+    size_t write(uint8_t c) override;
+
+protected:
+    void writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+    void fillCircleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t corners, int16_t delta, uint16_t color);
+
+    int16_t WIDTH;
+    int16_t HEIGHT;
+    int16_t _width;
+    int16_t _height;
+    int16_t cursor_x;
+    int16_t cursor_y;
+    uint16_t textcolor;
+    uint16_t textbgcolor;
+    uint8_t textsize;
+    uint8_t rotation;
+    bool wrap;
+};
+
+class Adafruit_SPITFT : public Adafruit_GFX {
+public:
+    Adafruit_SPITFT(uint16_t w, uint16_t h, int8_t cs, int8_t dc, int8_t rst);
+
+    virtual void setAddrWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h) = 0;
+
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+    void writePixel(int16_t x, int16_t y, uint16_t color) override;
+    void writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+    void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+    void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+    void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+    void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+    void invertDisplay(bool i) override;
+
+    void sendCommand(uint8_t command, const uint8_t* data = nullptr, uint8_t len = 0);
+    void setSPISpeed(uint32_t hz);
+    // Streams `len` pixels of one colour into the open window, row by row.
+    void writeColor(uint16_t color, uint32_t len);
+
+    // Host only: the panel contents in the current rotation's coordinates.
+    uint16_t hostPixel(int16_t x, int16_t y) const;
+    bool hostInverted() const;
+    // Host only: lets a harness find a panel owned by the code under test.
+    static const Adafruit_SPITFT* hostLastConstructed();
+
+protected:
+    void writeFillRectPreclipped(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+
+    std::vector<uint16_t> framebuffer_;
+    uint16_t window_x_;
+    uint16_t window_y_;
+    uint16_t window_w_;
+    uint16_t window_h_;
+    uint32_t window_pos_;
+    bool inverted_;
+};
+
+class Adafruit_ST77xx : public Adafruit_SPITFT {
+public:
+    Adafruit_ST77xx(uint16_t w, uint16_t h, int8_t cs, int8_t rs, int8_t rst = -1);
+
+    void setAddrWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h) override;
+
+protected:
+    uint16_t windowWidth;
+    uint16_t windowHeight;
+};
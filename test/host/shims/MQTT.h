@@ -0,0 +1,38 @@
+#pragma once
+
+// Host stand-in for the MQTT library (0.4.32): the same constructor, connect,
+// publish, subscribe and loop calls, talking to the in-memory FakeBroker in
+// fake_broker.h instead of a socket. Only QoS 0 is modelled, which is all the
+// firmware uses.
+
+#include "Particle.h"
+
+#define MQTT_MAX_PACKET_SIZE 255
+
+class MQTT {
+public:
+    typedef void (*Callback)(char* topic, uint8_t* payload, unsigned int length);
+
+    MQTT(const char* domain, uint16_t port, Callback callback);
+    MQTT(const uint8_t* ip, uint16_t port, Callback callback);
+    MQTT(const uint8_t* ip, uint16_t port, int maxpacketsize, Callback callback);
+    ~MQTT();
+
+    // Blocks for the broker's CONNACK (or refusal) like the library does.
+    bool connect(const char* id);
+    bool connect(const char* id, const char* user, const char* pass);
+    void disconnect();
+    bool isConnected();
+
+    bool publish(const char* topic, const char* payload);
+    bool publish(const char* topic, const uint8_t* payload, unsigned int plength);
+    bool subscribe(const char* topic);
+
+    // Hands at most one inbound message to the callback per call.
+    bool loop();
+
+private:
+    Callback callback_;
+    int max_packet_size_;
+    uint32_t session_;  // 0 until connected
+};
@@ -0,0 +1,190 @@
+#pragma once
+
+// Host stand-in for the parts of Device OS the firmware sources use, so single
+// modules build with the system compiler. Time is virtual: millis() and
+// micros() only move through delay() or the host* controls at the bottom.
+// Threads run one at a time: a worker only executes while the main thread is
+// inside delay(), and hands control back when it calls delay() itself.
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <string>
+
+typedef uint16_t pin_t;
+
+enum : pin_t { D0 = 0, D1, D2, D3, D4, D5, D6, D7, A0 = 10, A1, A2, A3, A4, A5, A6, A7 };
+enum : uint8_t { LOW = 0, HIGH = 1 };
+enum PinMode { INPUT, OUTPUT, INPUT_PULLUP, INPUT_PULLDOWN };
+
+#define SYSTEM_MODE(mode)
+#define SYSTEM_THREAD(state)
+
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+
+void pinMode(pin_t pin, PinMode mode);
+void digitalWrite(pin_t pin, uint8_t value);
+int32_t digitalRead(pin_t pin);
+
+typedef void os_thread_return_t;
+typedef os_thread_return_t (*os_thread_fn_t)(void* arg);
+typedef uint8_t os_thread_prio_t;
+const os_thread_prio_t OS_THREAD_PRIORITY_DEFAULT = 2;
+const size_t OS_THREAD_STACK_SIZE_DEFAULT = 3072;
+
+class Thread {
+public:
+    // Scheduler state, defined in particle_shim.cpp.
+    struct Context;
+
+    Thread(const char* name,
+           os_thread_fn_t fn,
+           void* arg = nullptr,
+           os_thread_prio_t priority = OS_THREAD_PRIORITY_DEFAULT,
+           size_t stack_size = OS_THREAD_STACK_SIZE_DEFAULT);
+
+    bool isValid() const {
+        return context_ != nullptr;
+    }
+
+private:
+    Context* context_;
+};
+
+class String {
+public:
+    String() {}
+    String(const char* s) : s_(s != nullptr ? s : "") {}
+
+    const char* c_str() const {
+        return s_.c_str();
+    }
+    unsigned int length() const {
+        return static_cast<unsigned int>(s_.size());
+    }
+    char charAt(unsigned int i) const {
+        return (i < s_.size()) ? s_[i] : '\0';
+    }
+
+private:
+    std::string s_;
+};
+
+class Print {
+public:
+    virtual ~Print() {}
+
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buf, size_t len);
+
+    size_t print(const char* s);
+    size_t print(int value);
+    size_t println(const char* s);
+    size_t println();
+    size_t printf(const char* format, ...);
+};
+
+class IPAddress {
+public:
+    IPAddress() : a_{0, 0, 0, 0} {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : a_{a, b, c, d} {}
+
+    uint8_t operator[](int i) const {
+        return a_[i & 3];
+    }
+    operator bool() const {
+        return (a_[0] | a_[1] | a_[2] | a_[3]) != 0;
+    }
+
+private:
+    uint8_t a_[4];
+};
+
+class WiFiClass {
+public:
+    bool ready() const {
+        return ready_;
+    }
+    IPAddress localIP() const {
+        return local_ip_;
+    }
+    IPAddress resolve(const char* host);
+
+    // Host controls.
+    void hostSetReady(bool ready) {
+        ready_ = ready;
+    }
+    void hostSetLocalIP(const IPAddress& ip) {
+        local_ip_ = ip;
+    }
+    void hostSetResolveResult(const IPAddress& ip) {
+        resolve_result_ = ip;
+    }
+
+private:
+    bool ready_ = false;
+    IPAddress local_ip_;
+    IPAddress resolve_result_;
+};
+extern WiFiClass WiFi;
+
+class SystemClass {
+public:
+    String deviceID() {
+        return String("e00fce68a1b2c3d4e5f60718");
+    }
+};
+extern SystemClass System;
+
+class TimeClass {
+public:
+    bool isValid() const {
+        return valid_;
+    }
+    uint32_t now() const;
+
+    // Host controls: once set, now() follows millis() from `unix_at_set`.
+    void hostSetUnix(uint32_t unix_at_set);
+
+private:
+    bool valid_ = false;
+    uint32_t unix_base_ = 0;
+    uint32_t millis_base_ = 0;
+};
+extern TimeClass Time;
+
+// Backed by a zeroed byte array the size of the Photon's emulated EEPROM.
+class EEPROMClass {
+public:
+    static const size_t kSize = 2047;
+
+    template <typename T>
+    T& get(int addr, T& out) {
+        memcpy(&out, bytes_ + addr, sizeof(T));
+        return out;
+    }
+    template <typename T>
+    const T& put(int addr, const T& value) {
+        memcpy(bytes_ + addr, &value, sizeof(T));
+        return value;
+    }
+
+private:
+    uint8_t bytes_[kSize] = {};
+};
+extern EEPROMClass EEPROM;
+
+// Host controls for the virtual clock. hostAdvanceMillis() is delay() for the
+// main thread; hostSpendMicros() moves the clock without running any thread,
+// as a busy call would.
+void hostAdvanceMillis(uint32_t ms);
+void hostSpendMicros(uint32_t us);
+// The virtual clock without micros()'s 32-bit wrap.
+uint64_t hostNowMicros();
+uint8_t hostPinLevel(pin_t pin);
@@ -0,0 +1,107 @@
+#pragma once
+
+// In-memory broker behind the fake MQTT client. There is one per process
+// (hostBroker()); harnesses script it between loop ticks and read back what
+// it received, with virtual-clock timestamps.
+//
+// Outbound publishes pass through a send window that drains at a fixed byte
+// rate, standing in for the TCP window and a broker that is slow to ACK: a
+// publish that does not fit is refused, as the library's socket write would
+// be, and an accepted one is delivered once the bytes ahead of it and its own
+// have drained.
+
+#include "MQTT.h"
+
+#include <deque>
+#include <string>
+#include <vector>
+
+class FakeBroker {
+public:
+    struct Delivery {
+        std::string topic;
+        std::string payload;
+        uint32_t session;
+        uint32_t published_ms;
+        uint32_t delivered_ms;
+        // The session dropped while the message was still in the send window.
+        bool lost;
+    };
+
+    // Back to a reachable broker with an unlimited window and no messages.
+    void reset();
+
+    // Going down drops the live session and everything still in its window.
+    void setUp(bool up);
+    bool up() const {
+        return up_;
+    }
+    // CONNACK arrives this long after CONNECT; a connect to a down broker
+    // fails after `refuse_ms` (connection refused or timed out).
+    void setConnectTiming(uint32_t connack_ms, uint32_t refuse_ms);
+    // 0 bytes/s means the window never fills and delivery is immediate.
+    void setSendWindow(uint32_t window_bytes, uint32_t drain_bytes_per_s);
+    // Time one publish() call spends in the socket write.
+    void setPublishCostUs(uint32_t base_us, uint32_t per_byte_ns);
+
+    // Queues a broker-to-client message if the live session subscribes to a
+    // matching filter ('#' and '+' wildcards); returns false otherwise.
+    bool inject(const char* topic, const char* payload);
+
+    const std::vector<Delivery>& deliveries() const {
+        return deliveries_;
+    }
+    size_t pendingInbound() const {
+        return inbound_.size();
+    }
+    uint32_t sessionsOpened() const {
+        return next_session_ - 1;
+    }
+    uint32_t connectAttempts() const {
+        return connect_attempts_;
+    }
+    uint32_t refusedPublishes() const {
+        return refused_publishes_;
+    }
+
+    // Used by the fake MQTT client. connect() blocks through delay() and
+    // returns the new session, or 0 when refused; a new session replaces the
+    // previous one.
+    uint32_t connect(int max_packet_size);
+    bool sessionAlive(uint32_t session) const;
+    void closeSession(uint32_t session);
+    bool subscribe(uint32_t session, const char* filter);
+    bool publish(uint32_t session, const char* topic, const uint8_t* payload, unsigned int length);
+    bool nextInbound(uint32_t session, std::string& topic, std::string& payload);
+
+private:
+    struct InFlight {
+        size_t delivery;  // index into deliveries_
+        uint32_t bytes;
+        uint64_t drained_us;
+    };
+
+    void drainWindow(uint64_t now_us);
+    bool matches(const std::string& filter, const char* topic) const;
+
+    bool up_ = true;
+    uint32_t connack_ms_ = 0;
+    uint32_t refuse_ms_ = 0;
+    uint32_t window_bytes_ = 0;
+    uint32_t drain_bytes_per_s_ = 0;
+    uint32_t cost_base_us_ = 0;
+    uint32_t cost_per_byte_ns_ = 0;
+
+    uint32_t live_session_ = 0;
+    uint32_t next_session_ = 1;
+    int max_packet_size_ = MQTT_MAX_PACKET_SIZE;
+    std::vector<std::string> filters_;
+    std::deque<InFlight> window_;
+    uint32_t window_used_ = 0;
+    std::deque<std::pair<std::string, std::string>> inbound_;
+    std::vector<Delivery> deliveries_;
+    uint32_t connect_attempts_ = 0;
+    uint32_t refused_publishes_ = 0;
+};
+
+FakeBroker& hostBroker();
@@ -0,0 +1,246 @@
+#include "MQTT.h"
+#include "fake_broker.h"
+
+#include <algorithm>
+
+namespace {
+// Fixed header (with up to four length bytes) as the library reserves it,
+// plus the topic length field.
+const unsigned int kPublishOverhead = 5 + 2;
+
+FakeBroker broker;
+}  // namespace
+
+FakeBroker& hostBroker() {
+    return broker;
+}
+
+void FakeBroker::reset() {
+    closeSession(live_session_);
+    up_ = true;
+    connack_ms_ = 0;
+    refuse_ms_ = 0;
+    window_bytes_ = 0;
+    drain_bytes_per_s_ = 0;
+    cost_base_us_ = 0;
+    cost_per_byte_ns_ = 0;
+    deliveries_.clear();
+    connect_attempts_ = 0;
+    refused_publishes_ = 0;
+    next_session_ = 1;
+}
+
+void FakeBroker::setUp(bool up) {
+    if (!up) {
+        closeSession(live_session_);
+    }
+    up_ = up;
+}
+
+void FakeBroker::setConnectTiming(uint32_t connack_ms, uint32_t refuse_ms) {
+    connack_ms_ = connack_ms;
+    refuse_ms_ = refuse_ms;
+}
+
+void FakeBroker::setSendWindow(uint32_t window_bytes, uint32_t drain_bytes_per_s) {
+    window_bytes_ = window_bytes;
+    drain_bytes_per_s_ = drain_bytes_per_s;
+}
+
+void FakeBroker::setPublishCostUs(uint32_t base_us, uint32_t per_byte_ns) {
+    cost_base_us_ = base_us;
+    cost_per_byte_ns_ = per_byte_ns;
+}
+
+bool FakeBroker::inject(const char* topic, const char* payload) {
+    if (!sessionAlive(live_session_)) {
+        return false;
+    }
+    for (const std::string& filter : filters_) {
+        if (matches(filter, topic)) {
+            inbound_.emplace_back(topic, payload);
+            return true;
+        }
+    }
+    return false;
+}
+
+uint32_t FakeBroker::connect(int max_packet_size) {
+    connect_attempts_ += 1;
+    if (!up_) {
+        delay(refuse_ms_);
+        return 0;
+    }
+    delay(connack_ms_);
+    if (!up_) {
+        return 0;
+    }
+    closeSession(live_session_);
+    live_session_ = next_session_++;
+    max_packet_size_ = max_packet_size;
+    return live_session_;
+}
+
+bool FakeBroker::sessionAlive(uint32_t session) const {
+    return up_ && session != 0 && session == live_session_;
+}
+
+void FakeBroker::closeSession(uint32_t session) {
+    if (session == 0 || session != live_session_) {
+        return;
+    }
+    drainWindow(hostNowMicros());
+    for (const InFlight& in_flight : window_) {
+        deliveries_[in_flight.delivery].lost = true;
+    }
+    window_.clear();
+    window_used_ = 0;
+    filters_.clear();
+    inbound_.clear();
+    live_session_ = 0;
+}
+
+bool FakeBroker::subscribe(uint32_t session, const char* filter) {
+    if (!sessionAlive(session)) {
+        return false;
+    }
+    filters_.emplace_back(filter);
+    return true;
+}
+
+bool FakeBroker::publish(uint32_t session, const char* topic, const uint8_t* payload, unsigned int length) {
+    if (!sessionAlive(session)) {
+        return false;
+    }
+    uint32_t bytes = kPublishOverhead + static_cast<uint32_t>(strlen(topic)) + length;
+    if (bytes > static_cast<uint32_t>(max_packet_size_)) {
+        return false;
+    }
+    hostSpendMicros(cost_base_us_);
+    uint64_t now_us = hostNowMicros();
+    drainWindow(now_us);
+    if (drain_bytes_per_s_ != 0 && window_used_ + bytes > window_bytes_) {
+        refused_publishes_ += 1;
+        return false;
+    }
+    hostSpendMicros(static_cast<uint32_t>(static_cast<uint64_t>(bytes) * cost_per_byte_ns_ / 1000));
+    now_us = hostNowMicros();
+
+    uint64_t drained_us = now_us;
+    if (drain_bytes_per_s_ != 0) {
+        uint64_t start_us = window_.empty() ? now_us : std::max(now_us, window_.back().drained_us);
+        drained_us = start_us + static_cast<uint64_t>(bytes) * 1000000 / drain_bytes_per_s_;
+        window_.push_back(InFlight{deliveries_.size(), bytes, drained_us});
+        window_used_ += bytes;
+    }
+    Delivery delivery;
+    delivery.topic = topic;
+    delivery.payload.assign(reinterpret_cast<const char*>(payload), length);
+    delivery.session = session;
+    delivery.published_ms = static_cast<uint32_t>(now_us / 1000);
+    delivery.delivered_ms = static_cast<uint32_t>(drained_us / 1000);
+    delivery.lost = false;
+    deliveries_.push_back(delivery);
+    return true;
+}
+
+bool FakeBroker::nextInbound(uint32_t session, std::string& topic, std::string& payload) {
+    if (!sessionAlive(session) || inbound_.empty()) {
+        return false;
+    }
+    topic = inbound_.front().first;
+    payload = inbound_.front().second;
+    inbound_.pop_front();
+    return true;
+}
+
+void FakeBroker::drainWindow(uint64_t now_us) {
+    while (!window_.empty() && window_.front().drained_us <= now_us) {
+        window_used_ -= window_.front().bytes;
+        window_.pop_front();
+    }
+}
+
+// MQTT filter matching: '+' is one level, a trailing '#' the rest.
+bool FakeBroker::matches(const std::string& filter, const char* topic) const {
+    size_t f = 0;
+    const char* t = topic;
+    while (f < filter.size()) {
+        if (filter[f] == '#') {
+            return true;
+        }
+        if (filter[f] == '+') {
+            while (*t != '\0' && *t != '/') {
+                ++t;
+            }
+            ++f;
+            continue;
+        }
+        if (*t != filter[f]) {
+            return false;
+        }
+        ++f;
+        ++t;
+    }
+    return *t == '\0';
+}
+
+MQTT::MQTT(const char* domain, uint16_t port, Callback callback)
+    : callback_(callback), max_packet_size_(MQTT_MAX_PACKET_SIZE), session_(0) {}
+
+MQTT::MQTT(const uint8_t* ip, uint16_t port, Callback callback)
+    : callback_(callback), max_packet_size_(MQTT_MAX_PACKET_SIZE), session_(0) {}
+
+MQTT::MQTT(const uint8_t* ip, uint16_t port, int maxpacketsize, Callback callback)
+    : callback_(callback), max_packet_size_(maxpacketsize), session_(0) {}
+
+MQTT::~MQTT() {
+    disconnect();
+}
+
+bool MQTT::connect(const char* id) {
+    return connect(id, nullptr, nullptr);
+}
+
+bool MQTT::connect(const char* id, const char* user, const char* pass) {
+    session_ = broker.connect(max_packet_size_);
+    return session_ != 0;
+}
+
+void MQTT::disconnect() {
+    broker.closeSession(session_);
+    session_ = 0;
+}
+
+bool MQTT::isConnected() {
+    return broker.sessionAlive(session_);
+}
+
+bool MQTT::publish(const char* topic, const char* payload) {
+    return publish(topic, reinterpret_cast<const uint8_t*>(payload), static_cast<unsigned int>(strlen(payload)));
+}
+
+bool MQTT::publish(const char* topic, const uint8_t* payload, unsigned int plength) {
+    return broker.publish(session_, topic, payload, plength);
+}
+
+bool MQTT::subscribe(const char* topic) {
+    return broker.subscribe(session_, topic);
+}
+
+bool MQTT::loop() {
+    if (!isConnected()) {
+        return false;
+    }
+    std::string topic;
+    std::string payload;
+    if (broker.nextInbound(session_, topic, payload) && callback_ != nullptr) {
+        // The library hands out pointers into its receive buffer.
+        std::vector<char> topic_buf(topic.begin(), topic.end());
+        topic_buf.push_back('\0');
+        std::vector<uint8_t> payload_buf(payload.begin(), payload.end());
+        payload_buf.push_back(0);
+        callback_(topic_buf.data(), payload_buf.data(), static_cast<unsigned int>(payload.size()));
+    }
+    return true;
+}
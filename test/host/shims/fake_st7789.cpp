@@ -0,0 +1,398 @@
+#include "Adafruit_ST7789.h"
+
+#include <stdlib.h>
+
+#include <utility>
+
+namespace {
+const Adafruit_SPITFT* last_constructed_panel = nullptr;
+
+// Stand-in glyph columns (bit 0 = top row). Space and control characters are
+// blank like in the real font; everything else gets a boxed pattern unique to
+// its code so text changes show up in the framebuffer.
+uint8_t glyphColumn(unsigned char c, uint8_t column) {
+    if (c <= ' ' || c >= 0x7F) {
+        return 0;
+    }
+    uint32_t h = (static_cast<uint32_t>(c) + 1) * 2654435761UL;
+    uint8_t bits = static_cast<uint8_t>((h >> (column * 5 + 2)) & 0x7F);
+    if (column == 0 || column == 4) {
+        bits |= 0x7F;
+    }
+    return static_cast<uint8_t>(bits | 0x41);
+}
+}  // namespace
+
+Adafruit_GFX::Adafruit_GFX(int16_t w, int16_t h)
+    : WIDTH(w),
+      HEIGHT(h),
+      _width(w),
+      _height(h),
+      cursor_x(0),
+      cursor_y(0),
+      textcolor(0xFFFF),
+      textbgcolor(0xFFFF),
+      textsize(1),
+      rotation(0),
+      wrap(true) {}
+
+void Adafruit_GFX::writePixel(int16_t x, int16_t y, uint16_t color) {
+    drawPixel(x, y, color);
+}
+
+void Adafruit_GFX::writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    writeFillRect(x, y, 1, h, color);
+}
+
+void Adafruit_GFX::writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    writeFillRect(x, y, w, 1, color);
+}
+
+void Adafruit_GFX::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    writeFillRect(x, y, w, h, color);
+}
+
+void Adafruit_GFX::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    writeFastVLine(x, y, h, color);
+}
+
+void Adafruit_GFX::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    writeFastHLine(x, y, w, color);
+}
+
+void Adafruit_GFX::fillScreen(uint16_t color) {
+    fillRect(0, 0, _width, _height, color);
+}
+
+void Adafruit_GFX::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+    if (x0 == x1) {
+        if (y0 > y1) {
+            std::swap(y0, y1);
+        }
+        drawFastVLine(x0, y0, y1 - y0 + 1, color);
+    } else if (y0 == y1) {
+        if (x0 > x1) {
+            std::swap(x0, x1);
+        }
+        drawFastHLine(x0, y0, x1 - x0 + 1, color);
+    } else {
+        writeLine(x0, y0, x1, y1, color);
+    }
+}
+
+// Bresenham, one pixel write per step, as in Adafruit_GFX::writeLine().
+void Adafruit_GFX::writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+    bool steep = abs(y1 - y0) > abs(x1 - x0);
+    if (steep) {
+        std::swap(x0, y0);
+        std::swap(x1, y1);
+    }
+    if (x0 > x1) {
+        std::swap(x0, x1);
+        std::swap(y0, y1);
+    }
+    int16_t dx = x1 - x0;
+    int16_t dy = static_cast<int16_t>(abs(y1 - y0));
+    int16_t err = dx / 2;
+    int16_t ystep = (y0 < y1) ? 1 : -1;
+    for (; x0 <= x1; ++x0) {
+        if (steep) {
+            writePixel(y0, x0, color);
+        } else {
+            writePixel(x0, y0, color);
+        }
+        err -= dy;
+        if (err < 0) {
+            y0 += ystep;
+            err += dx;
+        }
+    }
+}
+
+void Adafruit_GFX::fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+    writeFastVLine(x0, y0 - r, 2 * r + 1, color);
+    fillCircleHelper(x0, y0, r, 3, 0, color);
+}
+
+// Vertical spans mirrored around the centre column, as in Adafruit_GFX.
+void Adafruit_GFX::fillCircleHelper(int16_t x0,
+                                    int16_t y0,
+                                    int16_t r,
+                                    uint8_t corners,
+                                    int16_t delta,
+                                    uint16_t color) {
+    int16_t f = 1 - r;
+    int16_t ddf_x = 1;
+    int16_t ddf_y = -2 * r;
+    int16_t x = 0;
+    int16_t y = r;
+    int16_t px = x;
+    int16_t py = y;
+
+    delta++;
+    while (x < y) {
+        if (f >= 0) {
+            y--;
+            ddf_y += 2;
+            f += ddf_y;
+        }
+        x++;
+        ddf_x += 2;
+        f += ddf_x;
+        if (x < (y + 1)) {
+            if (corners & 1) {
+                writeFastVLine(x0 + x, y0 - y, 2 * y + delta, color);
+            }
+            if (corners & 2) {
+                writeFastVLine(x0 - x, y0 - y, 2 * y + delta, color);
+            }
+        }
+        if (y != py) {
+            if (corners & 1) {
+                writeFastVLine(x0 + py, y0 - px, 2 * px + delta, color);
+            }
+            if (corners & 2) {
+                writeFastVLine(x0 - py, y0 - px, 2 * px + delta, color);
+            }
+            py = y;
+        }
+        px = x;
+    }
+}
+
+void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size) {
+    if (x >= _width || y >= _height || (x + 6 * size - 1) < 0 || (y + 8 * size - 1) < 0) {
+        return;
+    }
+    for (int8_t i = 0; i < 5; ++i) {
+        uint8_t line = glyphColumn(c, static_cast<uint8_t>(i));
+        for (int8_t j = 0; j < 8; ++j, line >>= 1) {
+            if (line & 1) {
+                if (size == 1) {
+                    writePixel(x + i, y + j, color);
+                } else {
+                    writeFillRect(x + i * size, y + j * size, size, size, color);
+                }
+            } else if (bg != color) {
+                if (size == 1) {
+                    writePixel(x + i, y + j, bg);
+                } else {
+                    writeFillRect(x + i * size, y + j * size, size, size, bg);
+                }
+            }
+        }
+    }
+    if (bg != color) {
+        if (size == 1) {
+            writeFastVLine(x + 5, y, 8, bg);
+        } else {
+            writeFillRect(x + 5 * size, y, size, 8 * size, bg);
+        }
+    }
+}
+
+size_t Adafruit_GFX::write(uint8_t c) {
+    if (c == '\n') {
+        cursor_x = 0;
+        cursor_y += textsize * 8;
+    } else if (c != '\r') {
+        if (wrap && (cursor_x + textsize * 6) > _width) {
+            cursor_x = 0;
+            cursor_y += textsize * 8;
+        }
+        drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor, textsize);
+        cursor_x += textsize * 6;
+    }
+    return 1;
+}
+
+void Adafruit_GFX::setRotation(uint8_t r) {
+    rotation = r & 3;
+    bool swap = (rotation & 1) != 0;
+    _width = swap ? HEIGHT : WIDTH;
+    _height = swap ? WIDTH : HEIGHT;
+}
+
+void Adafruit_GFX::invertDisplay(bool i) {}
+
+void Adafruit_GFX::setCursor(int16_t x, int16_t y) {
+    cursor_x = x;
+    cursor_y = y;
+}
+
+void Adafruit_GFX::setTextColor(uint16_t c) {
+    textcolor = c;
+    textbgcolor = c;
+}
+
+void Adafruit_GFX::setTextColor(uint16_t c, uint16_t bg) {
+    textcolor = c;
+    textbgcolor = bg;
+}
+
+void Adafruit_GFX::setTextSize(uint8_t s) {
+    textsize = (s > 0) ? s : 1;
+}
+
+void Adafruit_GFX::setTextWrap(bool w) {
+    wrap = w;
+}
+
+int16_t Adafruit_GFX::width() const {
+    return _width;
+}
+
+int16_t Adafruit_GFX::height() const {
+    return _height;
+}
+
+Adafruit_SPITFT::Adafruit_SPITFT(uint16_t w, uint16_t h, int8_t cs, int8_t dc, int8_t rst)
+    : Adafruit_GFX(w, h),
+      framebuffer_(static_cast<size_t>(w) * h, 0),
+      window_x_(0),
+      window_y_(0),
+      window_w_(0),
+      window_h_(0),
+      window_pos_(0),
+      inverted_(false) {
+    last_constructed_panel = this;
+}
+
+void Adafruit_SPITFT::drawPixel(int16_t x, int16_t y, uint16_t color) {
+    writePixel(x, y, color);
+}
+
+void Adafruit_SPITFT::writePixel(int16_t x, int16_t y, uint16_t color) {
+    if (x < 0 || x >= _width || y < 0 || y >= _height) {
+        return;
+    }
+    setAddrWindow(x, y, 1, 1);
+    writeColor(color, 1);
+}
+
+// Clipping follows Adafruit_SPITFT::writeFillRect(), negative sizes included.
+void Adafruit_SPITFT::writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    if (w == 0 || h == 0) {
+        return;
+    }
+    if (w < 0) {
+        x += w + 1;
+        w = -w;
+    }
+    if (h < 0) {
+        y += h + 1;
+        h = -h;
+    }
+    if (x >= _width || y >= _height) {
+        return;
+    }
+    int16_t x2 = x + w - 1;
+    int16_t y2 = y + h - 1;
+    if (x2 < 0 || y2 < 0) {
+        return;
+    }
+    if (x < 0) {
+        x = 0;
+        w = x2 + 1;
+    }
+    if (y < 0) {
+        y = 0;
+        h = y2 + 1;
+    }
+    if (x2 >= _width) {
+        w = _width - x;
+    }
+    if (y2 >= _height) {
+        h = _height - y;
+    }
+    writeFillRectPreclipped(x, y, w, h, color);
+}
+
+void Adafruit_SPITFT::writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    writeFillRect(x, y, 1, h, color);
+}
+
+void Adafruit_SPITFT::writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    writeFillRect(x, y, w, 1, color);
+}
+
+void Adafruit_SPITFT::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    writeFillRect(x, y, w, h, color);
+}
+
+void Adafruit_SPITFT::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    writeFillRect(x, y, 1, h, color);
+}
+
+void Adafruit_SPITFT::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    writeFillRect(x, y, w, 1, color);
+}
+
+void Adafruit_SPITFT::invertDisplay(bool i) {
+    inverted_ = i;
+}
+
+void Adafruit_SPITFT::sendCommand(uint8_t command, const uint8_t* data, uint8_t len) {}
+
+void Adafruit_SPITFT::setSPISpeed(uint32_t hz) {}
+
+void Adafruit_SPITFT::writeFillRectPreclipped(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    setAddrWindow(x, y, w, h);
+    writeColor(color, static_cast<uint32_t>(w) * h);
+}
+
+void Adafruit_SPITFT::writeColor(uint16_t color, uint32_t len) {
+    uint32_t area = static_cast<uint32_t>(window_w_) * window_h_;
+    if (area == 0) {
+        return;
+    }
+    for (uint32_t i = 0; i < len; ++i) {
+        int x = window_x_ + static_cast<int>(window_pos_ % window_w_);
+        int y = window_y_ + static_cast<int>(window_pos_ / window_w_);
+        if (x < _width && y < _height) {
+            framebuffer_[static_cast<size_t>(y) * _width + x] = color;
+        }
+        window_pos_ = (window_pos_ + 1) % area;
+    }
+}
+
+uint16_t Adafruit_SPITFT::hostPixel(int16_t x, int16_t y) const {
+    if (x < 0 || x >= _width || y < 0 || y >= _height) {
+        return 0;
+    }
+    return framebuffer_[static_cast<size_t>(y) * _width + x];
+}
+
+bool Adafruit_SPITFT::hostInverted() const {
+    return inverted_;
+}
+
+const Adafruit_SPITFT* Adafruit_SPITFT::hostLastConstructed() {
+    return last_constructed_panel;
+}
+
+Adafruit_ST77xx::Adafruit_ST77xx(uint16_t w, uint16_t h, int8_t cs, int8_t rs, int8_t rst)
+    : Adafruit_SPITFT(w, h, cs, rs, rst), windowWidth(w), windowHeight(h) {}
+
+void Adafruit_ST77xx::setAddrWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
+    window_x_ = x;
+    window_y_ = y;
+    window_w_ = w;
+    window_h_ = h;
+    window_pos_ = 0;
+}
+
+Adafruit_ST7789::Adafruit_ST7789(int8_t cs, int8_t dc, int8_t rst) : Adafruit_ST77xx(240, 320, cs, dc, rst) {}
+
+void Adafruit_ST7789::init(uint16_t width, uint16_t height, uint8_t spi_mode) {
+    windowWidth = width;
+    windowHeight = height;
+    WIDTH = static_cast<int16_t>(width);
+    HEIGHT = static_cast<int16_t>(height);
+    framebuffer_.assign(static_cast<size_t>(width) * height, 0);
+    setRotation(0);
+}
+
+void Adafruit_ST7789::setRotation(uint8_t m) {
+    Adafruit_GFX::setRotation(m);
+}
@@ -0,0 +1,177 @@
+#include "Particle.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct Thread::Context {
+    os_thread_fn_t fn;
+    void* arg;
+    uint64_t wake_us;
+    bool finished;
+};
+
+namespace {
+uint64_t now_us = 0;
+uint8_t pin_levels[A7 + 1];
+
+// Exactly one thread holds the CPU: the worker in `running`, or the main
+// thread when it is null. Control only changes hands inside delay().
+std::mutex sched_mutex;
+std::condition_variable sched_cv;
+Thread::Context* running = nullptr;
+thread_local Thread::Context* current = nullptr;
+std::vector<Thread::Context*> workers;
+
+void switchTo(std::unique_lock<std::mutex>& lock, Thread::Context* next) {
+    running = next;
+    sched_cv.notify_all();
+    Thread::Context* self = current;
+    sched_cv.wait(lock, [self] { return running == self; });
+}
+
+void workerEntry(Thread::Context* context) {
+    current = context;
+    {
+        std::unique_lock<std::mutex> lock(sched_mutex);
+        sched_cv.wait(lock, [context] { return running == context; });
+    }
+    context->fn(context->arg);
+    std::unique_lock<std::mutex> lock(sched_mutex);
+    context->finished = true;
+    running = nullptr;
+    sched_cv.notify_all();
+}
+
+// Runs every worker due before `target_us` in wake order, then sets the clock.
+void advanceMainTo(uint64_t target_us) {
+    while (true) {
+        Thread::Context* next = nullptr;
+        for (Thread::Context* worker : workers) {
+            if (!worker->finished && worker->wake_us <= target_us &&
+                (next == nullptr || worker->wake_us < next->wake_us)) {
+                next = worker;
+            }
+        }
+        if (next == nullptr) {
+            break;
+        }
+        if (next->wake_us > now_us) {
+            now_us = next->wake_us;
+        }
+        std::unique_lock<std::mutex> lock(sched_mutex);
+        switchTo(lock, next);
+    }
+    now_us = target_us;
+}
+}  // namespace
+
+// Workers are detached and never joined; harnesses that start threads leave
+// through _exit().
+Thread::Thread(const char* name, os_thread_fn_t fn, void* arg, os_thread_prio_t priority, size_t stack_size)
+    : context_(new Context{fn, arg, now_us, false}) {
+    workers.push_back(context_);
+    std::thread(workerEntry, context_).detach();
+}
+
+WiFiClass WiFi;
+SystemClass System;
+TimeClass Time;
+EEPROMClass EEPROM;
+
+uint32_t millis() {
+    return static_cast<uint32_t>(now_us / 1000);
+}
+
+uint32_t micros() {
+    return static_cast<uint32_t>(now_us);
+}
+
+void delay(uint32_t ms) {
+    if (current == nullptr) {
+        advanceMainTo(now_us + static_cast<uint64_t>(ms) * 1000);
+        return;
+    }
+    std::unique_lock<std::mutex> lock(sched_mutex);
+    current->wake_us = now_us + static_cast<uint64_t>(ms) * 1000;
+    switchTo(lock, nullptr);
+}
+
+void hostAdvanceMillis(uint32_t ms) {
+    delay(ms);
+}
+
+void hostSpendMicros(uint32_t us) {
+    now_us += us;
+}
+
+uint64_t hostNowMicros() {
+    return now_us;
+}
+
+void pinMode(pin_t pin, PinMode mode) {}
+
+void digitalWrite(pin_t pin, uint8_t value) {
+    if (pin <= A7) {
+        pin_levels[pin] = value;
+    }
+}
+
+int32_t digitalRead(pin_t pin) {
+    return hostPinLevel(pin);
+}
+
+uint8_t hostPinLevel(pin_t pin) {
+    return (pin <= A7) ? pin_levels[pin] : 0;
+}
+
+size_t Print::write(const uint8_t* buf, size_t len) {
+    size_t n = 0;
+    for (size_t i = 0; i < len; ++i) {
+        n += write(buf[i]);
+    }
+    return n;
+}
+
+size_t Print::print(const char* s) {
+    return write(reinterpret_cast<const uint8_t*>(s), strlen(s));
+}
+
+size_t Print::print(int value) {
+    char text[12];
+    snprintf(text, sizeof(text), "%d", value);
+    return print(text);
+}
+
+size_t Print::println(const char* s) {
+    size_t n = print(s);
+    return n + println();
+}
+
+size_t Print::println() {
+    return print("\r\n");
+}
+
+size_t Print::printf(const char* format, ...) {
+    char text[256];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+    return print(text);
+}
+
+IPAddress WiFiClass::resolve(const char* host) {
+    return ready_ ? resolve_result_ : IPAddress();
+}
+
+uint32_t TimeClass::now() const {
+    return valid_ ? unix_base_ + (millis() - millis_base_) / 1000 : 0;
+}
+
+void TimeClass::hostSetUnix(uint32_t unix_at_set) {
+    valid_ = true;
+    unix_base_ = unix_at_set;
+    millis_base_ = millis();
+}
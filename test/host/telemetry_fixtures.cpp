@@ -0,0 +1,95 @@
+// Writes state.bin and history.bin from the firmware encoders for a fixed,
+// documented DeviceState. The records are checked in under tools/fixtures/
+// and decoded field by field in tools/test_aeris_telemetry.py, so the two
+// sides of the format cannot drift apart silently.
+//
+//   telemetry_fixtures DIR
+//
+// Inputs (keep in step with the expectations in test_aeris_telemetry.py):
+//   boot_ms 1000, now_ms 3727000              -> uptime_s 3726
+//   last_sensor_packet_ms 3726150             -> sensor_age_ms 850
+//   pm25_smooth 37, pm10_smooth 52, fan_percent 65
+//   lights on, screen light off, Wi-Fi ready, MQTT connected and enabled
+//   counters, in state.bin order: 3, 5, 7, 11, 13, 17, 19, 1234, 5678901, 42
+//   PM2.5 history: 130 samples, sample `seq` = (seq * 3) % 200, so the
+//   128-entry ring has wrapped and holds seq 2..129
+
+#include "Particle.h"
+
+#include "../../src/core/device_state.h"
+#include "../../src/net/telemetry_codec.h"
+
+#include <stdio.h>
+
+#include <string>
+
+namespace {
+const uint32_t kBootMs = 1000;
+const uint32_t kNowMs = 3727000;
+const uint32_t kHistorySamples = 130;
+
+bool writeRecord(const std::string& path, const uint8_t* data, size_t len) {
+    if (len == 0) {
+        fprintf(stderr, "encoder overflow for %s\n", path.c_str());
+        return false;
+    }
+    FILE* f = fopen(path.c_str(), "wb");
+    if (f == nullptr) {
+        fprintf(stderr, "cannot write %s\n", path.c_str());
+        return false;
+    }
+    bool ok = fwrite(data, 1, len, f) == len;
+    return (fclose(f) == 0) && ok;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        fprintf(stderr, "usage: %s DIR\n", argv[0]);
+        return 2;
+    }
+    std::string dir = argv[1];
+
+    static DeviceState state;
+    initDeviceState(state, kBootMs);
+    state.last_sensor_packet_ms = kNowMs - 850;
+    state.pm25_smooth = 37;
+    state.pm10_smooth = 52;
+    state.fan_percent = 65;
+    state.lights_on = true;
+    state.screen_light_on = false;
+    state.wifi_ready = true;
+    state.mqtt_connected = true;
+
+    MetricsRegistry& m = state.metrics;
+    m.add(MetricId::WifiReconnects, 3);
+    m.add(MetricId::MqttReconnects, 5);
+    m.add(MetricId::SensorParseErrors, 7);
+    m.add(MetricId::CommandDropsButton, 11);
+    m.add(MetricId::CommandDropsMqtt, 13);
+    m.add(MetricId::CommandDropsWeb, 17);
+    m.add(MetricId::MqttPublishDrops, 19);
+    m.add(MetricId::DisplayUpdates, 1234);
+    m.add(MetricId::DisplayBytes, 5678901);
+    m.add(MetricId::HttpResponses, 42);
+
+    for (uint32_t seq = 0; seq < kHistorySamples; ++seq) {
+        state.pm25_history.push(static_cast<uint16_t>((seq * 3) % 200));
+    }
+
+    uint8_t state_bin[kStateBinSize];
+    uint8_t history_bin[kHistoryBinMaxSize];
+    size_t state_len = encodeStateBin(state, true, kNowMs, state_bin, sizeof(state_bin));
+    size_t history_len = encodeHistoryBin(state, history_bin, sizeof(history_bin));
+
+    bool ok = writeRecord(dir + "/state.bin", state_bin, state_len);
+    ok = writeRecord(dir + "/history.bin", history_bin, history_len) && ok;
+    if (ok) {
+        printf("wrote %s/state.bin (%zu bytes), %s/history.bin (%zu bytes)\n",
+               dir.c_str(),
+               state_len,
+               dir.c_str(),
+               history_len);
+    }
+    return ok ? 0 : 1;
+}
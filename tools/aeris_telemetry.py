@@ -0,0 +1,109 @@
+#!/usr/bin/env python3
+"""Decode the binary telemetry records served by the firmware.
+
+`GET /api/v2/state.bin` and `GET /api/v2/history.bin` return fixed-layout
+little-endian records (see src/net/telemetry_codec.h). Each starts with an
+8-byte header: 4-byte magic, u16 schema version, u16 payload length. The same
+version is echoed in the `X-Aeris-Schema` response header.
+
+Use as a module (`decode_state`, `decode_history`) or from the command line:
+
+    tools/aeris_telemetry.py 192.168.1.40            # state.bin
+    tools/aeris_telemetry.py 192.168.1.40 --history  # history.bin
+"""
+
+import json
+import struct
+import sys
+import urllib.request
+
+HEADER = struct.Struct("<4sHH")
+
+STATE_MAGIC = b"AEST"
+STATE_VERSION = 1
+STATE_PAYLOAD = struct.Struct("<IIHHBBH10I")
+STATE_COUNTERS = (
+    "wifi_reconnect_count",
+    "mqtt_reconnect_count",
+    "sensor_parse_errors",
+    "command_drop_button_count",
+    "command_drop_mqtt_count",
+    "command_drop_web_count",
+    "mqtt_publish_drop_count",
+    "display_update_count",
+    "display_bytes_total",
+    "http_response_count",
+)
+STATE_FLAGS = ("lights_on", "screen_light_on", "wifi_ready", "mqtt_connected", "mqtt_enabled")
+
+HISTORY_MAGIC = b"AEHI"
+HISTORY_VERSION = 1
+HISTORY_PREFIX = struct.Struct("<HHI")
+
+
+class DecodeError(ValueError):
+    pass
+
+
+def _payload(data, magic, version):
+    if len(data) < HEADER.size:
+        raise DecodeError("record shorter than header")
+    got_magic, got_version, length = HEADER.unpack_from(data)
+    if got_magic != magic:
+        raise DecodeError("unexpected magic %r" % got_magic)
+    if got_version != version:
+        raise DecodeError("unsupported schema version %d" % got_version)
+    payload = data[HEADER.size:]
+    if len(payload) < length:
+        raise DecodeError("truncated payload")
+    return payload[:length]
+
+
+def decode_state(data):
+    payload = _payload(data, STATE_MAGIC, STATE_VERSION)
+    if len(payload) < STATE_PAYLOAD.size:
+        raise DecodeError("state payload too short")
+    fields = STATE_PAYLOAD.unpack_from(payload)
+    uptime_s, sensor_age_ms, pm25, pm10, fan_percent, flags, _reserved = fields[:7]
+    state = {
+        "uptime_s": uptime_s,
+        "sensor_age_ms": sensor_age_ms,
+        "pm25": pm25,
+        "pm10": pm10,
+        "fan_percent": fan_percent,
+    }
+    for bit, name in enumerate(STATE_FLAGS):
+        state[name] = 1 if flags & (1 << bit) else 0
+    state.update(zip(STATE_COUNTERS, fields[7:]))
+    return state
+
+
+def decode_history(data):
+    payload = _payload(data, HISTORY_MAGIC, HISTORY_VERSION)
+    if len(payload) < HISTORY_PREFIX.size:
+        raise DecodeError("history payload too short")
+    interval_s, count, next_seq = HISTORY_PREFIX.unpack_from(payload)
+    if len(payload) < HISTORY_PREFIX.size + 2 * count:
+        raise DecodeError("history samples truncated")
+    samples = list(struct.unpack_from("<%dH" % count, payload, HISTORY_PREFIX.size))
+    return {
+        "interval_s": interval_s,
+        "next_seq": next_seq,
+        "first_seq": next_seq - count,
+        "pm25": samples,
+    }
+
+
+def main(argv):
+    if len(argv) < 2:
+        sys.exit("usage: aeris_telemetry.py <host> [--history]")
+    history = "--history" in argv[2:]
+    path = "/api/v2/history.bin" if history else "/api/v2/state.bin"
+    with urllib.request.urlopen("http://%s%s" % (argv[1], path), timeout=5) as response:
+        data = response.read()
+    decoded = decode_history(data) if history else decode_state(data)
+    print(json.dumps(decoded, indent=2))
+
+
+if __name__ == "__main__":
+    main(sys.argv)
@@ -0,0 +1,78 @@
+#!/usr/bin/env python3
+"""Embed web/index.html into src/net/web_ui_html.cpp.
+
+The dashboard is emitted twice: gzip-compressed for clients that send
+`Accept-Encoding: gzip` and as plain text for the rest. The ETag is the
+CRC32 of the page source, so it only changes when the page does.
+"""
+
+import gzip
+import os
+import sys
+import zlib
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SRC = os.path.join(ROOT, "web", "index.html")
+DST = os.path.join(ROOT, "src", "net", "web_ui_html.cpp")
+BYTES_PER_LINE = 16
+
+
+def main():
+    with open(SRC, "rb") as f:
+        html = f.read()
+    text = html.decode("utf-8")
+    if ')HTML"' in text:
+        sys.exit("index.html must not contain the raw-string delimiter )HTML\"")
+
+    # mtime=0 keeps the output byte-identical across rebuilds.
+    packed = gzip.compress(html, compresslevel=9, mtime=0)
+    etag = "%08x" % (zlib.crc32(html) & 0xFFFFFFFF)
+
+    rows = []
+    for i in range(0, len(packed), BYTES_PER_LINE):
+        chunk = packed[i:i + BYTES_PER_LINE]
+        rows.append("    " + ", ".join("0x%02x" % b for b in chunk) + ",")
+
+    out = []
+    out.append("// Generated by tools/gen_web_ui.py from web/index.html. Do not edit.")
+    out.append('#include "web_ui_html.h"')
+    out.append("")
+    out.append("namespace {")
+    out.append('const char kIndexHtml[] = R"HTML(' + text + ')HTML";')
+    out.append("")
+    out.append("const uint8_t kIndexHtmlGzip[] = {")
+    out.extend(rows)
+    out.append("};")
+    out.append("")
+    out.append('const char kIndexHtmlEtag[] = "\\"%s\\"";' % etag)
+    out.append('const char kIndexHtmlGzipEtag[] = "\\"%s-gz\\"";' % etag)
+    out.append("}  // namespace")
+    out.append("")
+    out.append("const char* webUiIndexHtml() {")
+    out.append("    return kIndexHtml;")
+    out.append("}")
+    out.append("")
+    out.append("size_t webUiIndexHtmlLength() {")
+    out.append("    return sizeof(kIndexHtml) - 1;")
+    out.append("}")
+    out.append("")
+    out.append("const uint8_t* webUiIndexHtmlGzip() {")
+    out.append("    return kIndexHtmlGzip;")
+    out.append("}")
+    out.append("")
+    out.append("size_t webUiIndexHtmlGzipLength() {")
+    out.append("    return sizeof(kIndexHtmlGzip);")
+    out.append("}")
+    out.append("")
+    out.append("const char* webUiIndexHtmlEtag(bool gzip) {")
+    out.append("    return gzip ? kIndexHtmlGzipEtag : kIndexHtmlEtag;")
+    out.append("}")
+    out.append("")
+
+    with open(DST, "w", newline="\n") as f:
+        f.write("\n".join(out))
+    print("web_ui_html.cpp: %d bytes html, %d bytes gzip, etag %s" % (len(html), len(packed), etag))
+
+
+if __name__ == "__main__":
+    main()
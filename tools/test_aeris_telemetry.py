@@ -0,0 +1,133 @@
+#!/usr/bin/env python3
+"""Tests for aeris_telemetry.py against records produced by the firmware.
+
+tools/fixtures/state.bin and history.bin come from the firmware encoders
+(encodeStateBin / encodeHistoryBin) via test/host/telemetry_fixtures.cpp; the
+input values listed there are the expectations below. Regenerate them with
+`make -C test/host update-goldens` after an intended format change.
+
+    python3 tools/test_aeris_telemetry.py
+"""
+
+import os
+import struct
+import sys
+import unittest
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+
+import aeris_telemetry  # noqa: E402
+
+FIXTURES = os.path.join(os.path.dirname(os.path.abspath(__file__)), "fixtures")
+
+EXPECTED_STATE = {
+    "uptime_s": 3726,
+    "sensor_age_ms": 850,
+    "pm25": 37,
+    "pm10": 52,
+    "fan_percent": 65,
+    "lights_on": 1,
+    "screen_light_on": 0,
+    "wifi_ready": 1,
+    "mqtt_connected": 1,
+    "mqtt_enabled": 1,
+    "wifi_reconnect_count": 3,
+    "mqtt_reconnect_count": 5,
+    "sensor_parse_errors": 7,
+    "command_drop_button_count": 11,
+    "command_drop_mqtt_count": 13,
+    "command_drop_web_count": 17,
+    "mqtt_publish_drop_count": 19,
+    "display_update_count": 1234,
+    "display_bytes_total": 5678901,
+    "http_response_count": 42,
+}
+
+# 130 samples pushed into the 128-entry ring: seq 0 and 1 are gone.
+HISTORY_NEXT_SEQ = 130
+HISTORY_FIRST_SEQ = 2
+EXPECTED_HISTORY = {
+    "interval_s": 30,
+    "next_seq": HISTORY_NEXT_SEQ,
+    "first_seq": HISTORY_FIRST_SEQ,
+    "pm25": [(seq * 3) % 200 for seq in range(HISTORY_FIRST_SEQ, HISTORY_NEXT_SEQ)],
+}
+
+
+def read_fixture(name):
+    with open(os.path.join(FIXTURES, name), "rb") as f:
+        return f.read()
+
+
+def with_payload(record, payload):
+    """Re-wraps `payload` under the header of `record` with a patched length."""
+    magic, version, _length = aeris_telemetry.HEADER.unpack_from(record)
+    return aeris_telemetry.HEADER.pack(magic, version, len(payload)) + payload
+
+
+class StateTest(unittest.TestCase):
+    def setUp(self):
+        self.record = read_fixture("state.bin")
+
+    def test_layout(self):
+        self.assertEqual(aeris_telemetry.STATE_PAYLOAD.format, "<IIHHBBH10I")
+        self.assertEqual(aeris_telemetry.STATE_PAYLOAD.size, 56)
+        self.assertEqual(len(self.record), aeris_telemetry.HEADER.size + 56)
+        magic, version, length = aeris_telemetry.HEADER.unpack_from(self.record)
+        self.assertEqual(magic, b"AEST")
+        self.assertEqual(version, 1)
+        self.assertEqual(length, 56)
+
+    def test_every_field(self):
+        self.assertEqual(aeris_telemetry.decode_state(self.record), EXPECTED_STATE)
+
+    def test_appended_fields_are_ignored(self):
+        payload = self.record[aeris_telemetry.HEADER.size:]
+        longer = with_payload(self.record, payload + struct.pack("<IH", 0xDEADBEEF, 7))
+        self.assertEqual(aeris_telemetry.decode_state(longer), EXPECTED_STATE)
+
+    def test_trailing_bytes_after_payload_are_ignored(self):
+        self.assertEqual(aeris_telemetry.decode_state(self.record + b"\x00\x01"), EXPECTED_STATE)
+
+    def test_short_payload_is_rejected(self):
+        payload = self.record[aeris_telemetry.HEADER.size:]
+        with self.assertRaises(aeris_telemetry.DecodeError):
+            aeris_telemetry.decode_state(with_payload(self.record, payload[:52]))
+        with self.assertRaises(aeris_telemetry.DecodeError):
+            aeris_telemetry.decode_state(self.record[:40])
+
+    def test_wrong_magic_or_version_is_rejected(self):
+        with self.assertRaises(aeris_telemetry.DecodeError):
+            aeris_telemetry.decode_state(read_fixture("history.bin"))
+        bumped = self.record[:4] + struct.pack("<H", 2) + self.record[6:]
+        with self.assertRaises(aeris_telemetry.DecodeError):
+            aeris_telemetry.decode_state(bumped)
+
+
+class HistoryTest(unittest.TestCase):
+    def setUp(self):
+        self.record = read_fixture("history.bin")
+
+    def test_layout(self):
+        magic, version, length = aeris_telemetry.HEADER.unpack_from(self.record)
+        self.assertEqual(magic, b"AEHI")
+        self.assertEqual(version, 1)
+        self.assertEqual(length, aeris_telemetry.HISTORY_PREFIX.size + 2 * 128)
+        self.assertEqual(len(self.record), aeris_telemetry.HEADER.size + length)
+
+    def test_every_field(self):
+        self.assertEqual(aeris_telemetry.decode_history(self.record), EXPECTED_HISTORY)
+
+    def test_appended_fields_are_ignored(self):
+        payload = self.record[aeris_telemetry.HEADER.size:]
+        longer = with_payload(self.record, payload + struct.pack("<I", 99))
+        self.assertEqual(aeris_telemetry.decode_history(longer), EXPECTED_HISTORY)
+
+    def test_truncated_samples_are_rejected(self):
+        payload = self.record[aeris_telemetry.HEADER.size:]
+        with self.assertRaises(aeris_telemetry.DecodeError):
+            aeris_telemetry.decode_history(with_payload(self.record, payload[:-2]))
+
+
+if __name__ == "__main__":
+    unittest.main()